@@ -26,6 +26,10 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import <Foundation/Foundation.h>
+#import "SafeCastEnumerationFunctions.h"
+
+@class SafeCastFilter;
+@class SafeCastSequence;
 
 /**
  Type-safe operations on elements of an NSArray.
@@ -65,6 +69,42 @@
  */
 - (void)safe_makeObjectsSafelyPerformSelector:(nonnull SEL)aSelector withObject:(nullable id)anObject;
 
+/**
+ Sends to each object in the array that responds to the given selector the message it identifies, and returns the non-nil results, in the order of the array.
+
+ The implementation of the selector is looked up once for each class of object rather than once per object, and the result array is created with the array's count as its capacity before the pass.
+
+ Objects whose implementation of the selector does not return an object, such as one returning a number or void, are skipped.
+
+ This method raises an NSInvalidArgumentException if aSelector is NULL or belongs to the alloc, new, copy, mutableCopy or init families, whose methods return retained objects.
+
+ @code
+ NSArray *identifiers = [array safe_mapObjectsPerformingSelector:@selector(identifier)];
+ @endcode
+
+ @param aSelector A selector that identifies the message to send to the objects in the array. The method must not take any arguments, and must not have the side effect of modifying the receiving array.
+
+ @return An array of the non-nil values returned by the objects that respond to aSelector.
+
+ @see safe_mapObjectsPerformingSelector:withObject:
+ */
+- (nonnull NSArray *)safe_mapObjectsPerformingSelector:(nonnull SEL)aSelector;
+
+/**
+ Sends to each object in the array that responds to the given selector the message it identifies, with anObject as the argument, and returns the non-nil results, in the order of the array.
+
+ Objects whose implementation of the selector does not return an object are skipped. This method raises an NSInvalidArgumentException if aSelector is NULL or belongs to the alloc, new, copy, mutableCopy or init families.
+
+ @param aSelector A selector that identifies the message to send to the objects in the array. The method must take a single argument of type id, and must not have the side effect of modifying the receiving array.
+
+ @param anObject The object to send as the argument to each invocation of the aSelector method.
+
+ @return An array of the non-nil values returned by the objects that respond to aSelector.
+
+ @see safe_mapObjectsPerformingSelector:
+ */
+- (nonnull NSArray *)safe_mapObjectsPerformingSelector:(nonnull SEL)aSelector withObject:(nullable id)anObject;
+
 #pragma mark - Of Kind
 
 /**
@@ -311,4 +351,715 @@
  */
 - (void)safe_enumerateObjectsRespondingToSelector:(nonnull SEL)selector atIndexes:(nonnull NSIndexSet *)s options:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
 
+/**
+ Returns the indexes of objects in the array that respond to the given selector.
+
+ @param selector The selector objects in the array must respond to for their index to be returned in the index set
+
+ @return The indexes whose corresponding objects in the array respond to the selector. If no objects in the array respond to it, returns an empty index set.
+ */
+- (nonnull NSIndexSet *)safe_indexesOfObjectsRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Of Any of Several Kinds
+
+/**
+ @name Operations on objects that are a kind of any of several classes.
+ */
+
+/**
+ Executes a given block using each object in the array that is a kind of any of the given classes, in a single pass over the array.
+
+ Which of the classes an object matches is decided once per class of object, so the cost per element does not grow with the number of classes.
+
+ @param classes The classes to match objects in the array against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param block The block to apply to elements in the array.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using each object in the array that is a kind of any of the given classes.
+
+ @param classes The classes to match objects in the array against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param opts A bit mask that specifies the options for the enumeration (whether it should be performed concurrently and whether it should be performed in reverse order).
+
+ @param block The block to apply to elements in the array.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using the objects in the array at the specified indexes that are a kind of any of the given classes.
+
+ @param classes The classes to match objects in the array against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param indexSet The indexes of the objects over which to enumerate.
+
+ @param opts A bit mask that specifies the options for the enumeration (whether it should be performed concurrently and whether it should be performed in reverse order).
+
+ @param block The block to apply to elements in the array.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes atIndexes:(nonnull NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Returns the indexes of objects in the array that are a kind of any of the given classes.
+
+ @param classes The classes to match objects in the array against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @return The indexes of matching objects. If no objects in the array match, returns an empty index set.
+ */
+- (nonnull NSIndexSet *)safe_indexesOfObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes;
+
+#pragma mark - Matching a Filter
+
+/**
+ @name Operations on objects that match a SafeCastFilter.
+ */
+
+/**
+ Executes a given block using each object in the array that matches the filter, starting with the first object and continuing through the array to the last object.
+
+ @param filter The filter objects in the array must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param block The block to apply to elements in the array.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsMatchingFilter:(nonnull SafeCastFilter *)filter usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using each object in the array that matches the filter.
+
+ @param filter The filter objects in the array must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param opts A bit mask that specifies the options for the enumeration (whether it should be performed concurrently and whether it should be performed in reverse order).
+
+ @param block The block to apply to elements in the array.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsMatchingFilter:(nonnull SafeCastFilter *)filter withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using the objects in the array at the specified indexes that match the filter.
+
+ @param filter The filter objects in the array must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param indexSet The indexes of the objects over which to enumerate.
+
+ @param opts A bit mask that specifies the options for the enumeration (whether it should be performed concurrently and whether it should be performed in reverse order).
+
+ @param block The block to apply to elements in the array.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsMatchingFilter:(nonnull SafeCastFilter *)filter atIndexes:(nonnull NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Returns the indexes of objects in the array that match the filter.
+
+ @param filter The filter objects in the array must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @return The indexes of matching objects. If no objects in the array match, returns an empty index set.
+ */
+- (nonnull NSIndexSet *)safe_indexesOfObjectsMatchingFilter:(nonnull SafeCastFilter *)filter;
+
+#pragma mark - Filtering
+
+/**
+ @name Filtering into a new collection
+ */
+
+/**
+ Returns the objects in the array that are of the kind of the given Class, in the order they appear in the array.
+
+ Elements are pulled from the array in batches and the result is built with a single allocation, without invoking any blocks.
+
+ @param class The Class objects in the array must be a kind of to be included in the result
+
+ @return An array of the objects in the array that are of the kind of the given Class. If no objects in the array pass the test, returns an empty array.
+ */
+- (nonnull NSArray *)safe_objectsOfKind:(nonnull Class)class;
+
+/**
+ Returns the objects in the array that conform to the given protocol, in the order they appear in the array.
+
+ Elements are pulled from the array in batches and the result is built with a single allocation, without invoking any blocks.
+
+ @param protocol The Protocol objects in the array must conform to to be included in the result
+
+ @return An array of the objects in the array that conform to the given protocol. If no objects in the array pass the test, returns an empty array.
+ */
+- (nonnull NSArray *)safe_objectsConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the objects in the array that respond to the given selector, in the order they appear in the array.
+
+ Elements are pulled from the array in batches and the result is built with a single allocation, without invoking any blocks.
+
+ @param selector The selector objects in the array must respond to to be included in the result
+
+ @return An array of the objects in the array that respond to the given selector. If no objects in the array pass the test, returns an empty array.
+ */
+- (nonnull NSArray *)safe_objectsRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Partitioning
+
+/**
+ @name Partitioning by kind
+ */
+
+/**
+ Splits the objects in the array into one array per class, in a single pass over the array.
+
+ Each object goes into the bucket of the first class in classes it is a kind of. Objects that are a kind of none of them go into a final, unmatched bucket. Within each bucket, objects keep their order in the array. Every result array is created at its exact final size.
+
+ @param classes The classes to partition by, as an array of classes or a SafeCastClassSet.
+
+ @return An array with one array per class, in the order of classes, followed by an array of the unmatched objects. Buckets with no objects are empty arrays.
+ */
+- (nonnull NSArray *)safe_partitionObjectsByKinds:(nonnull id<NSFastEnumeration>)classes;
+
+#pragma mark - Aggregate Queries
+
+/**
+ @name Counting and finding objects without building a collection
+ */
+
+/**
+ Returns the number of objects in the array that are a kind of the given class, without allocating.
+
+ @param class The class to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsOfKind:(nonnull Class)class;
+
+/**
+ Returns the first object in the array that is a kind of the given class, or nil. The search stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (nullable id)safe_firstObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns the last object in the array that is a kind of the given class, or nil. The search starts at the end of the array and stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (nullable id)safe_lastObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns YES if any of the objects in the array are a kind of the given class. The search stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (BOOL)safe_containsObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns the number of objects in the array that conform to the given protocol, without allocating.
+
+ @param protocol The protocol to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the first object in the array that conforms to the given protocol, or nil. The search stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (nullable id)safe_firstObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the last object in the array that conforms to the given protocol, or nil. The search starts at the end of the array and stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (nullable id)safe_lastObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns YES if any of the objects in the array conform to the given protocol. The search stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (BOOL)safe_containsObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the number of objects in the array that respond to the given selector, without allocating.
+
+ @param selector The selector to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns the first object in the array that responds to the given selector, or nil. The search stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (nullable id)safe_firstObjectRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns the last object in the array that responds to the given selector, or nil. The search starts at the end of the array and stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (nullable id)safe_lastObjectRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns YES if any of the objects in the array respond to the given selector. The search stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (BOOL)safe_containsObjectRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Enumerating with a Function
+
+/**
+ @name Enumeration with a C function instead of a block
+ */
+
+/**
+ Calls a C function for each object in the array that is a kind of the given class.
+
+ Unlike the block-based methods, no block is invoked and objects are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously, in order.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param class The Class objects must be a kind of for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateObjectsOfKind:(nonnull Class)class function:(nonnull SafeCastIndexedEnumerationFunction)function context:(nullable void *)context;
+
+/**
+ Calls a C function for each object in the array that conforms to the given protocol.
+
+ Unlike the block-based methods, no block is invoked and objects are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously, in order.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param protocol The Protocol objects must conform to for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateObjectsConformingToProtocol:(nonnull Protocol *)protocol function:(nonnull SafeCastIndexedEnumerationFunction)function context:(nullable void *)context;
+
+/**
+ Calls a C function for each object in the array that responds to the given selector.
+
+ Unlike the block-based methods, no block is invoked and objects are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously, in order.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param selector The selector objects must respond to for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateObjectsRespondingToSelector:(nonnull SEL)selector function:(nonnull SafeCastIndexedEnumerationFunction)function context:(nullable void *)context;
+
+#pragma mark - Fast Enumeration
+
+/**
+ @name Fast enumeration of objects matching a test
+ */
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects in the array that are of the kind of the given Class.
+
+ @code
+ for (MyModel *model in [array safe_fastEnumerationOfKind:[MyModel class]]) {
+     // ...
+ }
+ @endcode
+
+ Matching objects are compacted into the loop's own buffer batch by batch; no blocks are invoked and no intermediate collection is created. The returned object supports one enumeration at a time, and the array must not be mutated while it is being enumerated.
+
+ @param class The Class objects in the array must be a kind of to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationOfKind:(nonnull Class)class;
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects in the array that conform to the given protocol.
+
+ @param protocol The Protocol objects in the array must conform to to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+
+ @see safe_fastEnumerationOfKind:
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects in the array that respond to the given selector.
+
+ @param selector The selector objects in the array must respond to to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+
+ @see safe_fastEnumerationOfKind:
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns a lazy sequence over the objects in the array, to which filtering and mapping stages can be chained. The stages run in a single pass when a result is asked for.
+
+ @code
+ NSUInteger visible = [[[array.safe_sequence ofKind:[MyModel class]] respondingTo:@selector(draw)] count];
+ @endcode
+
+ @return A sequence over the array.
+
+ @see SafeCastSequence
+ */
+- (nonnull SafeCastSequence *)safe_sequence;
+
+#pragma mark - Lazy Views
+
+/**
+ @name Filtered views that do not copy
+ */
+
+/**
+ Returns an NSArray containing only the objects in the array that are of the kind of the given Class, without copying them.
+
+ @code
+ NSArray *models = [array safe_lazyArrayOfKind:[MyModel class]];
+ @endcode
+
+ The view finds matching objects on demand. The first access to an element or to the count walks the array only as far as needed and remembers where each match was found, so later accesses are served from that index map. For-in loops over the view read matching objects straight from the array without building the map.
+
+ The view keeps the array itself, not a copy. Mutating the array after making the view is an error, and the view raises NSGenericException on its next use. The view is immutable and may be shared between threads while the array is left unchanged.
+
+ @param class The Class objects in the array must be a kind of to be in the view
+
+ @return An NSArray of the objects in the array that are of the kind of class, in the same order.
+ */
+- (nonnull NSArray *)safe_lazyArrayOfKind:(nonnull Class)class;
+
+/**
+ Returns an NSArray containing only the objects in the array that conform to the given protocol, without copying them.
+
+ @param protocol The Protocol objects in the array must conform to to be in the view
+
+ @return An NSArray of the objects in the array that conform to protocol, in the same order.
+
+ @see safe_lazyArrayOfKind:
+ */
+- (nonnull NSArray *)safe_lazyArrayConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns an NSArray containing only the objects in the array that respond to the given selector, without copying them.
+
+ @param selector The selector objects in the array must respond to to be in the view
+
+ @return An NSArray of the objects in the array that respond to selector, in the same order.
+
+ @see safe_lazyArrayOfKind:
+ */
+- (nonnull NSArray *)safe_lazyArrayRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns an NSArray containing only the objects in the array that match the given filter, without copying them.
+
+ @param filter The filter objects in the array must match to be in the view
+
+ @return An NSArray of the objects in the array that match filter, in the same order.
+
+ @see safe_lazyArrayOfKind:
+ */
+- (nonnull NSArray *)safe_lazyArrayMatchingFilter:(nonnull SafeCastFilter *)filter;
+
+#pragma mark - Chunked Concurrent Enumeration
+
+/**
+ @name Concurrent enumeration in chunks
+ */
+
+/**
+ Executes a given block concurrently using each object in the array that is of the kind of the given Class, splitting the array into contiguous chunks of grainSize objects.
+
+ Chunks are handed to one worker per available processor with libdispatch; idle workers claim the next unprocessed chunk, so uneven work is balanced automatically. The test and the block run on the worker threads, and each chunk costs a single block invocation of scheduling overhead rather than one per element. This makes the method suited to large arrays and cheap blocks, where NSEnumerationConcurrent spends more time scheduling than working.
+
+ If the block sets *stop to YES, no further chunks are started and running chunks stop before their next element. Blocks already executing on other threads are allowed to finish.
+
+ This method executes synchronously. If the Block parameter is nil this method will raise an exception.
+
+ @param class The Class objects in the array must be a kind of for the block to be executed on
+
+ @param grainSize The number of consecutive objects processed as a unit by one worker. Pass 0 to let SafeCast choose a grain size from the size of the array and the number of processors.
+
+ @param block The block to apply to elements in the array. It must be safe to call concurrently from multiple threads.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsOfKind:(nonnull Class)class concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block concurrently using each object in the array that conforms to the given protocol, splitting the array into contiguous chunks of grainSize objects.
+
+ Chunks are handed to one worker per available processor with libdispatch; idle workers claim the next unprocessed chunk, so uneven work is balanced automatically. The test and the block run on the worker threads, and each chunk costs a single block invocation of scheduling overhead rather than one per element. This makes the method suited to large arrays and cheap blocks, where NSEnumerationConcurrent spends more time scheduling than working.
+
+ If the block sets *stop to YES, no further chunks are started and running chunks stop before their next element. Blocks already executing on other threads are allowed to finish.
+
+ This method executes synchronously. If the Block parameter is nil this method will raise an exception.
+
+ @param protocol The Protocol objects in the array must conform to for the block to be executed on
+
+ @param grainSize The number of consecutive objects processed as a unit by one worker. Pass 0 to let SafeCast choose a grain size from the size of the array and the number of processors.
+
+ @param block The block to apply to elements in the array. It must be safe to call concurrently from multiple threads.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsConformingToProtocol:(nonnull Protocol *)protocol concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block concurrently using each object in the array that responds to the given selector, splitting the array into contiguous chunks of grainSize objects.
+
+ Chunks are handed to one worker per available processor with libdispatch; idle workers claim the next unprocessed chunk, so uneven work is balanced automatically. The test and the block run on the worker threads, and each chunk costs a single block invocation of scheduling overhead rather than one per element. This makes the method suited to large arrays and cheap blocks, where NSEnumerationConcurrent spends more time scheduling than working.
+
+ If the block sets *stop to YES, no further chunks are started and running chunks stop before their next element. Blocks already executing on other threads are allowed to finish.
+
+ This method executes synchronously. If the Block parameter is nil this method will raise an exception.
+
+ @param selector The selector objects in the array must respond to for the block to be executed on
+
+ @param grainSize The number of consecutive objects processed as a unit by one worker. Pass 0 to let SafeCast choose a grain size from the size of the array and the number of processors.
+
+ @param block The block to apply to elements in the array. It must be safe to call concurrently from multiple threads.
+ The block takes three arguments:
+ obj
+ The element in the array.
+ idx
+ The index of the element in the array.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the array. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsRespondingToSelector:(nonnull SEL)selector concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(nonnull void (^)(__nonnull id obj, NSUInteger idx, BOOL * __nonnull stop))block;
+
+#pragma mark - Reducing and Mapping
+
+/**
+ @name Reducing and mapping objects matching a test
+ */
+
+/**
+ Combines the objects in the array that are of the kind of the given Class into a single value, in order.
+
+ @code
+ NSNumber *total = [array safe_reduceObjectsOfKind:[MyModel class]
+                                           initial:@0
+                                           combine:^id(NSNumber *sum, MyModel *model) { return @(sum.integerValue + model.size); }
+                                             merge:^id(NSNumber *left, NSNumber *right) { return @(left.integerValue + right.integerValue); }];
+ @endcode
+
+ The accumulator starts as initial, and each matching object replaces it with the result of calling combine with the accumulator and the object. This method runs serially and never calls merge; it is accepted so that switching to safe_reduceObjectsOfKind:concurrentlyWithGrainSize:initial:combine:merge: is a one-word change.
+
+ If the combine parameter is nil this method will raise an exception.
+
+ @param class The Class objects in the array must be a kind of to be combined
+
+ @param initial The starting value of the accumulator.
+
+ @param combine The block that folds one object into the accumulator and returns the new accumulator.
+
+ @param merge The block that combines two accumulators. May be nil.
+
+ @return The final accumulator, or initial if no objects are of the kind of class.
+ */
+- (nullable id)safe_reduceObjectsOfKind:(nonnull Class)class initial:(nullable id)initial combine:(nonnull id __nullable (^)(__nullable id accumulator, __nonnull id obj))combine merge:(nullable id __nullable (^)(__nullable id left, __nullable id right))merge;
+
+/**
+ Combines the objects in the array that are of the kind of the given Class into a single value, concurrently.
+
+ The array is split into contiguous chunks of grainSize objects and the chunks are handed to workers as in safe_enumerateObjectsOfKind:concurrentlyWithGrainSize:usingBlock:. Each chunk folds its matching objects into its own accumulator, starting from initial, so combine never sees an accumulator another thread is using. The chunks' accumulators are then merged pairwise, neighbors first, in a tree on the calling thread.
+
+ For the result to match a serial reduction, merge must be associative and initial must be an identity for it. The order of the objects is preserved, so merge need not be commutative.
+
+ This method executes synchronously. If the combine or merge parameter is nil this method will raise an exception.
+
+ @param class The Class objects in the array must be a kind of to be combined
+
+ @param grainSize The number of consecutive objects processed as a unit by one worker. Pass 0 to let SafeCast choose a grain size from the size of the array and the number of processors.
+
+ @param initial The starting value of each chunk's accumulator.
+
+ @param combine The block that folds one object into an accumulator and returns the new accumulator. It must be safe to call concurrently from multiple threads.
+
+ @param merge The block that combines the accumulators of two neighboring runs of chunks, left before right, and returns the combined accumulator.
+
+ @return The merged accumulator, or initial if the array is empty.
+ */
+- (nullable id)safe_reduceObjectsOfKind:(nonnull Class)class concurrentlyWithGrainSize:(NSUInteger)grainSize initial:(nullable id)initial combine:(nonnull id __nullable (^)(__nullable id accumulator, __nonnull id obj))combine merge:(nonnull id __nullable (^)(__nullable id left, __nullable id right))merge;
+
+/**
+ Returns an array of the non-nil results of calling a block with each object in the array that is of the kind of the given Class, in order.
+
+ Results are collected in an array created once with room for every object in the array, so it never has to grow.
+
+ If the Block parameter is nil this method will raise an exception.
+
+ @param class The Class objects in the array must be a kind of for the block to be called with
+
+ @param block The block to call with each matching object. Return nil to leave the object out of the result.
+
+ @return An array of the block's non-nil results.
+ */
+- (nonnull NSArray *)safe_compactMapObjectsOfKind:(nonnull Class)class usingBlock:(nonnull id __nullable (^)(__nonnull id obj))block;
+
+/**
+ Returns an array of the non-nil results of calling a block concurrently with each object in the array that is of the kind of the given Class, in the order of the objects.
+
+ Each chunk of grainSize objects collects its results in its own array, so workers share nothing. The chunks' arrays are then joined in order.
+
+ This method executes synchronously. If the Block parameter is nil this method will raise an exception.
+
+ @param class The Class objects in the array must be a kind of for the block to be called with
+
+ @param grainSize The number of consecutive objects processed as a unit by one worker. Pass 0 to let SafeCast choose a grain size from the size of the array and the number of processors.
+
+ @param block The block to call with each matching object. It must be safe to call concurrently from multiple threads. Return nil to leave the object out of the result.
+
+ @return An array of the block's non-nil results.
+ */
+- (nonnull NSArray *)safe_compactMapObjectsOfKind:(nonnull Class)class concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(nonnull id __nullable (^)(__nonnull id obj))block;
+
+/**
+ Combines the objects in the array that conform to the given protocol into a single value, in order.
+
+ @see safe_reduceObjectsOfKind:initial:combine:merge:
+ */
+- (nullable id)safe_reduceObjectsConformingToProtocol:(nonnull Protocol *)protocol initial:(nullable id)initial combine:(nonnull id __nullable (^)(__nullable id accumulator, __nonnull id obj))combine merge:(nullable id __nullable (^)(__nullable id left, __nullable id right))merge;
+
+/**
+ Combines the objects in the array that conform to the given protocol into a single value, concurrently.
+
+ @see safe_reduceObjectsOfKind:concurrentlyWithGrainSize:initial:combine:merge:
+ */
+- (nullable id)safe_reduceObjectsConformingToProtocol:(nonnull Protocol *)protocol concurrentlyWithGrainSize:(NSUInteger)grainSize initial:(nullable id)initial combine:(nonnull id __nullable (^)(__nullable id accumulator, __nonnull id obj))combine merge:(nonnull id __nullable (^)(__nullable id left, __nullable id right))merge;
+
+/**
+ Returns an array of the non-nil results of calling a block with each object in the array that conforms to the given protocol, in order.
+
+ @see safe_compactMapObjectsOfKind:usingBlock:
+ */
+- (nonnull NSArray *)safe_compactMapObjectsConformingToProtocol:(nonnull Protocol *)protocol usingBlock:(nonnull id __nullable (^)(__nonnull id obj))block;
+
+/**
+ Returns an array of the non-nil results of calling a block concurrently with each object in the array that conforms to the given protocol, in the order of the objects.
+
+ @see safe_compactMapObjectsOfKind:concurrentlyWithGrainSize:usingBlock:
+ */
+- (nonnull NSArray *)safe_compactMapObjectsConformingToProtocol:(nonnull Protocol *)protocol concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(nonnull id __nullable (^)(__nonnull id obj))block;
+
+/**
+ Combines the objects in the array that respond to the given selector into a single value, in order.
+
+ @see safe_reduceObjectsOfKind:initial:combine:merge:
+ */
+- (nullable id)safe_reduceObjectsRespondingToSelector:(nonnull SEL)selector initial:(nullable id)initial combine:(nonnull id __nullable (^)(__nullable id accumulator, __nonnull id obj))combine merge:(nullable id __nullable (^)(__nullable id left, __nullable id right))merge;
+
+/**
+ Combines the objects in the array that respond to the given selector into a single value, concurrently.
+
+ @see safe_reduceObjectsOfKind:concurrentlyWithGrainSize:initial:combine:merge:
+ */
+- (nullable id)safe_reduceObjectsRespondingToSelector:(nonnull SEL)selector concurrentlyWithGrainSize:(NSUInteger)grainSize initial:(nullable id)initial combine:(nonnull id __nullable (^)(__nullable id accumulator, __nonnull id obj))combine merge:(nonnull id __nullable (^)(__nullable id left, __nullable id right))merge;
+
+/**
+ Returns an array of the non-nil results of calling a block with each object in the array that responds to the given selector, in order.
+
+ @see safe_compactMapObjectsOfKind:usingBlock:
+ */
+- (nonnull NSArray *)safe_compactMapObjectsRespondingToSelector:(nonnull SEL)selector usingBlock:(nonnull id __nullable (^)(__nonnull id obj))block;
+
+/**
+ Returns an array of the non-nil results of calling a block concurrently with each object in the array that responds to the given selector, in the order of the objects.
+
+ @see safe_compactMapObjectsOfKind:concurrentlyWithGrainSize:usingBlock:
+ */
+- (nonnull NSArray *)safe_compactMapObjectsRespondingToSelector:(nonnull SEL)selector concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(nonnull id __nullable (^)(__nonnull id obj))block;
+
+@end
+
+/**
+ Type-safe compaction of an NSMutableArray.
+
+ Each method removes, in a single pass, every object that does not meet the criterion. Surviving objects are moved down in place, keeping their order, and the remainder of the array is removed as one range; no index sets or temporary collections are created.
+ */
+@interface NSMutableArray (SafeCast)
+
+/**
+ Removes the objects in the array that are not a kind of the given class.
+
+ @param class The class objects must be a kind of to stay in the array.
+ */
+- (void)safe_removeObjectsNotOfKind:(nonnull Class)class;
+
+/**
+ Removes the objects in the array that do not conform to the given protocol.
+
+ @param protocol The protocol objects must conform to in order to stay in the array.
+ */
+- (void)safe_removeObjectsNotConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Removes the objects in the array that do not respond to the given selector.
+
+ @param selector The selector objects must respond to in order to stay in the array.
+ */
+- (void)safe_removeObjectsNotRespondingToSelector:(nonnull SEL)selector;
+
 @end
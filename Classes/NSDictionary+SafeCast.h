@@ -25,6 +25,11 @@
 //  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#import "SafeCastEnumerationFunctions.h"
+
+@class SafeCastFilter;
+@class SafeCastSequence;
+
 /**
  Type-safe operations on elements of an NSDictionary.
 
@@ -53,7 +58,7 @@
 
  @param class The Class objects in the receiver must be a kind of in order to have the block operate on them
 
- @param opts Enumeration options.
+ @param opts Enumeration options. If opts contains NSEnumerationConcurrent, the keys and objects are copied out of the dictionary once and processed in contiguous chunks on multiple threads, and the block must be safe to call concurrently.
 
  @param block A block object to operate on entries in the dictionary.
 
@@ -81,7 +86,7 @@
 
  @param protocol The Protocol objects in the receiver must conform to in order to have the block operate on them
 
- @param opts Enumeration options.
+ @param opts Enumeration options. If opts contains NSEnumerationConcurrent, the keys and objects are copied out of the dictionary once and processed in contiguous chunks on multiple threads, and the block must be safe to call concurrently.
 
  @param block A block object to operate on entries in the dictionary.
 
@@ -107,7 +112,7 @@
 
  @param selector The selector objects in the ordered set must respond to for the block to be executed on them
 
- @param opts Enumeration options.
+ @param opts Enumeration options. If opts contains NSEnumerationConcurrent, the keys and objects are copied out of the dictionary once and processed in contiguous chunks on multiple threads, and the block must be safe to call concurrently.
 
  @param block A block object to operate on entries in the dictionary.
 
@@ -115,4 +120,307 @@
  */
 - (void)safe_enumerateKeysAndObjectsRespondingToSelector:(nonnull SEL)selector withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
 
-@end
\ No newline at end of file
+#pragma mark - Of Any of Several Kinds
+
+/**
+ @name Operations on objects that are a kind of any of several classes.
+ */
+
+/**
+ Applies a given block object to the entries of the dictionary whose object is a kind of any of the given classes, in a single pass over the dictionary.
+
+ @param classes The classes to match objects in the receiver against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param block A block object to operate on entries in the dictionary.
+ */
+- (void)safe_enumerateKeysAndObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+/**
+ Applies a given block object to the entries of the dictionary whose object is a kind of any of the given classes.
+
+ @param classes The classes to match objects in the receiver against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param opts Enumeration options. If opts contains NSEnumerationConcurrent, the keys and objects are copied out of the dictionary once and processed in contiguous chunks on multiple threads, and the block must be safe to call concurrently.
+
+ @param block A block object to operate on entries in the dictionary.
+
+ If the block sets *stop to YES, the enumeration stops.
+ */
+- (void)safe_enumerateKeysAndObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+#pragma mark - Matching a Filter
+
+/**
+ @name Operations on objects that match a SafeCastFilter.
+ */
+
+/**
+ Applies a given block object to the entries of the dictionary whose object matches the filter.
+
+ @param filter The filter objects in the receiver must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param block A block object to operate on entries in the dictionary.
+ */
+- (void)safe_enumerateKeysAndObjectsMatchingFilter:(nonnull SafeCastFilter *)filter usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+/**
+ Applies a given block object to the entries of the dictionary whose object matches the filter.
+
+ @param filter The filter objects in the receiver must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param opts Enumeration options. If opts contains NSEnumerationConcurrent, the keys and objects are copied out of the dictionary once and processed in contiguous chunks on multiple threads, and the block must be safe to call concurrently.
+
+ @param block A block object to operate on entries in the dictionary.
+
+ If the block sets *stop to YES, the enumeration stops.
+ */
+- (void)safe_enumerateKeysAndObjectsMatchingFilter:(nonnull SafeCastFilter *)filter withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+#pragma mark - Filtering
+
+/**
+ @name Filtering into a new collection
+ */
+
+/**
+ Returns the entries of the dictionary whose objects are of the kind of the given Class.
+
+ Entries are copied out of the dictionary in bulk and the result is built with a single allocation, without invoking any blocks.
+
+ @param class The Class objects in the dictionary must be a kind of to be included in the result
+
+ @return A dictionary of the entries in the receiver whose objects are of the kind of the given Class. If no objects in the dictionary pass the test, returns an empty dictionary.
+ */
+- (nonnull NSDictionary *)safe_keysAndObjectsOfKind:(nonnull Class)class;
+
+/**
+ Returns the entries of the dictionary whose objects conform to the given protocol.
+
+ Entries are copied out of the dictionary in bulk and the result is built with a single allocation, without invoking any blocks.
+
+ @param protocol The Protocol objects in the dictionary must conform to to be included in the result
+
+ @return A dictionary of the entries in the receiver whose objects conform to the given protocol. If no objects in the dictionary pass the test, returns an empty dictionary.
+ */
+- (nonnull NSDictionary *)safe_keysAndObjectsConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the entries of the dictionary whose objects respond to the given selector.
+
+ Entries are copied out of the dictionary in bulk and the result is built with a single allocation, without invoking any blocks.
+
+ @param selector The selector objects in the dictionary must respond to to be included in the result
+
+ @return A dictionary of the entries in the receiver whose objects respond to the given selector. If no objects in the dictionary pass the test, returns an empty dictionary.
+ */
+- (nonnull NSDictionary *)safe_keysAndObjectsRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Aggregate Queries
+
+/**
+ @name Counting and finding objects without building a collection
+ */
+
+/**
+ Returns the number of values in the dictionary that are a kind of the given class, without allocating.
+
+ @param class The class to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsOfKind:(nonnull Class)class;
+
+/**
+ Returns one of the values in the dictionary that are a kind of the given class, or nil. The search stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (nullable id)safe_anyObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns YES if any of the values in the dictionary are a kind of the given class. The search stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (BOOL)safe_containsObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns the number of values in the dictionary that conform to the given protocol, without allocating.
+
+ @param protocol The protocol to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns one of the values in the dictionary that conform to the given protocol, or nil. The search stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (nullable id)safe_anyObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns YES if any of the values in the dictionary conform to the given protocol. The search stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (BOOL)safe_containsObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the number of values in the dictionary that respond to the given selector, without allocating.
+
+ @param selector The selector to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns one of the values in the dictionary that respond to the given selector, or nil. The search stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (nullable id)safe_anyObjectRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns YES if any of the values in the dictionary respond to the given selector. The search stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (BOOL)safe_containsObjectRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Enumerating with a Function
+
+/**
+ @name Enumeration with a C function instead of a block
+ */
+
+/**
+ Calls a C function for each entry in the dictionary whose object is a kind of the given class.
+
+ Unlike the block-based methods, no block is invoked and entries are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param class The Class objects must be a kind of for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateKeysAndObjectsOfKind:(nonnull Class)class function:(nonnull SafeCastKeyedEnumerationFunction)function context:(nullable void *)context;
+
+/**
+ Calls a C function for each entry in the dictionary whose object conforms to the given protocol.
+
+ Unlike the block-based methods, no block is invoked and entries are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param protocol The Protocol objects must conform to for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateKeysAndObjectsConformingToProtocol:(nonnull Protocol *)protocol function:(nonnull SafeCastKeyedEnumerationFunction)function context:(nullable void *)context;
+
+/**
+ Calls a C function for each entry in the dictionary whose object responds to the given selector.
+
+ Unlike the block-based methods, no block is invoked and entries are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param selector The selector objects must respond to for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateKeysAndObjectsRespondingToSelector:(nonnull SEL)selector function:(nonnull SafeCastKeyedEnumerationFunction)function context:(nullable void *)context;
+
+#pragma mark - Fast Enumeration
+
+/**
+ @name Fast enumeration of objects matching a test
+ */
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects of the dictionary (not its keys) that are of the kind of the given Class.
+
+ @code
+ for (MyModel *model in [dictionary safe_fastEnumerationOfKind:[MyModel class]]) {
+     // ...
+ }
+ @endcode
+
+ Matching objects are compacted into the loop's own buffer batch by batch; no blocks are invoked and no intermediate collection is created. The returned object supports one enumeration at a time, and the dictionary must not be mutated while it is being enumerated.
+
+ @param class The Class objects in the dictionary must be a kind of to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationOfKind:(nonnull Class)class;
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects of the dictionary (not its keys) that conform to the given protocol.
+
+ @param protocol The Protocol objects in the dictionary must conform to to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+
+ @see safe_fastEnumerationOfKind:
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects of the dictionary (not its keys) that respond to the given selector.
+
+ @param selector The selector objects in the dictionary must respond to to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+
+ @see safe_fastEnumerationOfKind:
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns a lazy sequence over the values in the dictionary, to which filtering and mapping stages can be chained. The stages run in a single pass when a result is asked for.
+
+ @code
+ NSUInteger visible = [[[dictionary.safe_sequence ofKind:[MyModel class]] respondingTo:@selector(draw)] count];
+ @endcode
+
+ @return A sequence over the dictionary.
+
+ @see SafeCastSequence
+ */
+- (nonnull SafeCastSequence *)safe_sequence;
+
+@end
+
+/**
+ Type-safe compaction of an NSMutableDictionary.
+
+ Each method removes, in a single pass, every object that does not meet the criterion. Entries are removed by key; keys are never tested. No index sets or temporary collections are created.
+ */
+@interface NSMutableDictionary (SafeCast)
+
+/**
+ Removes the objects in the dictionary that are not a kind of the given class.
+
+ @param class The class objects must be a kind of to stay in the dictionary.
+ */
+- (void)safe_removeObjectsNotOfKind:(nonnull Class)class;
+
+/**
+ Removes the objects in the dictionary that do not conform to the given protocol.
+
+ @param protocol The protocol objects must conform to in order to stay in the dictionary.
+ */
+- (void)safe_removeObjectsNotConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Removes the objects in the dictionary that do not respond to the given selector.
+
+ @param selector The selector objects must respond to in order to stay in the dictionary.
+ */
+- (void)safe_removeObjectsNotRespondingToSelector:(nonnull SEL)selector;
+
+@end
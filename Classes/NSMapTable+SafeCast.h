@@ -0,0 +1,138 @@
+//
+//  NSMapTable+SafeCast.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ Type-safe operations on elements of an NSMapTable.
+ 
+ NSMapTable may hold weak references. Enumeration copies each batch of entries into strong references before testing or using them, so an object cannot be deallocated while a block or selector is acting on it. Entries whose weak references have been zeroed are skipped.
+
+ Entries are read as the map table's own fast enumeration hands them out, before they are made strong. As with a for-in loop over the map table, an object it holds only weakly must not be released on another thread while it is being enumerated; enumeration of weak entries is safe only when the objects' last strong references are released on the enumerating thread.
+ 
+ The map table's keys and values must be objects. Collections configured with opaque or integer pointer functions are not supported: their entries would be retained and sent messages as if they were objects.
+ */
+@interface NSMapTable (SafeCast)
+
+#pragma mark - Perform selector
+
+/**
+ @name Performing a selector
+ */
+
+/**
+ Sends to each live value in the map table the message identified by a given selector, if and only if the object responds to the given selector.
+ 
+ This method raises an NSInvalidArgumentException if aSelector is NULL.
+ 
+ @param aSelector A selector that identifies the message to send to the objects. The method must not take any arguments, and must not have the side effect of modifying the receiving map table.
+ 
+ @see - safe_makeObjectsSafelyPerformSelector:withObject:
+ */
+- (void)safe_makeObjectsSafelyPerformSelector:(nonnull SEL)aSelector;
+
+/**
+ Sends a selector message to each live value in the map table, if and only if the object responds to the given selector.
+ 
+ This method raises an NSInvalidArgumentException if aSelector is NULL.
+ 
+ @param aSelector A selector that identifies the message to send to the objects. The method must take a single argument of type id, and must not have the side effect of modifying the receiving map table.
+ 
+ @param anObject The object to send as the argument to each invocation of the aSelector method.
+ 
+ @see - safe_makeObjectsSafelyPerformSelector:
+ */
+- (void)safe_makeObjectsSafelyPerformSelector:(nonnull SEL)aSelector withObject:(nonnull id)anObject;
+
+#pragma mark - Enumeration
+
+/**
+ @name Enumerating live objects
+ */
+
+/**
+ Executes a given block using each live value in the map table that is a kind of the indicated Class.
+ 
+ If the Block parameter is nil this method will raise an exception.
+ 
+ This method executes synchronously.
+ 
+ @param class The Class objects must be a kind of for the block to be executed on them
+ 
+ @param block The block to apply to matching objects.
+ The block takes three arguments:
+ key
+ The key of the entry.
+ obj
+ The value of the entry.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the map table. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateKeysAndObjectsOfKind:(nonnull Class)class usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using each live value in the map table that conforms to the indicated Protocol.
+ 
+ If the Block parameter is nil this method will raise an exception.
+ 
+ This method executes synchronously.
+ 
+ @param protocol The Protocol objects must conform to for the block to be executed on them
+ 
+ @param block The block to apply to matching objects.
+ The block takes three arguments:
+ key
+ The key of the entry.
+ obj
+ The value of the entry.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the map table. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateKeysAndObjectsConformingToProtocol:(nonnull Protocol *)protocol usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using each live value in the map table that responds to the given selector.
+ 
+ If the Block parameter is nil this method will raise an exception.
+ 
+ This method executes synchronously.
+ 
+ @param selector The selector objects must respond to for the block to be executed on them
+ 
+ @param block The block to apply to matching objects.
+ The block takes three arguments:
+ key
+ The key of the entry.
+ obj
+ The value of the entry.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the map table. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateKeysAndObjectsRespondingToSelector:(nonnull SEL)selector usingBlock:(nonnull void (^)(__nonnull id key, __nonnull id obj, BOOL * __nonnull stop))block;
+
+@end
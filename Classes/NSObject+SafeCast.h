@@ -26,11 +26,14 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import <Foundation/Foundation.h>
+#import <objc/runtime.h>
 
 /**
  Conditional casting into any class.
 
  This category facilitates conditional casting and code execution of objects.
+
+ Decisions are cached per class of the object being cast, so repeatedly casting objects of the same class to the same target is a lookup rather than a walk up the class hierarchy. Classes that override -isKindOfClass: are always asked directly. Decisions are keyed by the address of the class and are never discarded, so classes destroyed with objc_disposeClassPair must not be cast through SafeCast; see SafeCastDecisionCache.h.
  */
 @interface NSObject (SafeCast)
 
@@ -67,3 +70,45 @@
 + (nullable instancetype)safe_cast:(nullable id)obj intoBlock:(nonnull void(^)(__nonnull id))block;
 
 @end
+
+/**
+ Equivalent to @code [obj isKindOfClass:cls] @endcode for a non-nil object, answered from a process-wide cache after the first time a given class of object is tested against cls. Returns NO for nil.
+ */
+FOUNDATION_EXTERN BOOL SafeCastIsKindOfClass(id __nullable obj, Class __nonnull cls);
+
+/**
+ Returns obj if it is an instance of cls or of one of its subclasses, and nil otherwise.
+
+ An object whose class is exactly cls is returned after an object_getClass() call and a compare, without sending any message. Everything else goes through SafeCastIsKindOfClass().
+ */
+static inline id __nullable SafeCastObjectOfKind(id __nullable obj, Class __nonnull cls)
+{
+    if (obj != nil && object_getClass(obj) == cls) {
+        return obj;
+    }
+    return SafeCastIsKindOfClass(obj, cls) ? obj : nil;
+}
+
+/**
+ An inline equivalent of +safe_cast: for a class named at compile time.
+
+ @code
+ MyModel *model = SAFE_CAST(MyModel, obj);
+ @endcode
+
+ The target class is resolved once per call site and kept in a static, so an exact-class hit costs a load of the static, an object_getClass() call and a compare, with no message send and no cache lookup. The static is read and written with relaxed atomics: threads that race on the first call each resolve the same class and store the same pointer. Subclass hits and misses fall back to the same cached hierarchy test +safe_cast: uses.
+
+ @param klass The name of the class to cast to.
+ @param obj The object to cast. It is evaluated exactly once.
+ @return obj typed as an instance of klass, or nil if it is not of that kind.
+ */
+#define SAFE_CAST(klass, obj) \
+    ({ \
+        static void *safeCastTarget_; \
+        Class safeCastClass_ = (__bridge Class)__atomic_load_n(&safeCastTarget_, __ATOMIC_RELAXED); \
+        if (__builtin_expect(safeCastClass_ == Nil, 0)) { \
+            safeCastClass_ = [klass class]; \
+            __atomic_store_n(&safeCastTarget_, (__bridge void *)safeCastClass_, __ATOMIC_RELAXED); \
+        } \
+        (klass *)SafeCastObjectOfKind((obj), safeCastClass_); \
+    })
@@ -26,12 +26,13 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "NSObject+SafeCast.h"
+#import "SafeCastDecisionCache.h"
 
 @implementation NSObject (SafeCast)
 
 + (instancetype)safe_cast:(id)obj
 {
-    if ([obj isKindOfClass:self]) {
+    if (SafeCastIsKindOfClass(obj, self)) {
         return obj;
     }
 
@@ -40,7 +41,7 @@
 
 + (instancetype)safe_cast:(id)obj intoBlock:(void(^)(id))block
 {
-    if ([obj isKindOfClass:self]) {
+    if (SafeCastIsKindOfClass(obj, self)) {
         if (block) {
             block(obj);
         }
@@ -25,6 +25,11 @@
 //  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#import "SafeCastEnumerationFunctions.h"
+
+@class SafeCastFilter;
+@class SafeCastSequence;
+
 /**
  Type-safe operations on elements of an NSSet.
  
@@ -63,6 +68,42 @@
  */
 - (void)safe_makeObjectsSafelyPerformSelector:(nonnull SEL)aSelector withObject:(nonnull id)anObject;
 
+/**
+ Sends to each object in the set that responds to the given selector the message it identifies, and returns the non-nil results in an array.
+
+ The implementation of the selector is looked up once for each class of object rather than once per object, and the result array is created with the set's count as its capacity before the pass.
+
+ Objects whose implementation of the selector does not return an object, such as one returning a number or void, are skipped.
+
+ This method raises an NSInvalidArgumentException if aSelector is NULL or belongs to the alloc, new, copy, mutableCopy or init families, whose methods return retained objects.
+
+ @code
+ NSArray *identifiers = [set safe_mapObjectsPerformingSelector:@selector(identifier)];
+ @endcode
+
+ @param aSelector A selector that identifies the message to send to the objects in the set. The method must not take any arguments, and must not have the side effect of modifying the receiving set.
+
+ @return An array of the non-nil values returned by the objects that respond to aSelector.
+
+ @see safe_mapObjectsPerformingSelector:withObject:
+ */
+- (nonnull NSArray *)safe_mapObjectsPerformingSelector:(nonnull SEL)aSelector;
+
+/**
+ Sends to each object in the set that responds to the given selector the message it identifies, with anObject as the argument, and returns the non-nil results in an array.
+
+ Objects whose implementation of the selector does not return an object are skipped. This method raises an NSInvalidArgumentException if aSelector is NULL or belongs to the alloc, new, copy, mutableCopy or init families.
+
+ @param aSelector A selector that identifies the message to send to the objects in the set. The method must take a single argument of type id, and must not have the side effect of modifying the receiving set.
+
+ @param anObject The object to send as the argument to each invocation of the aSelector method.
+
+ @return An array of the non-nil values returned by the objects that respond to aSelector.
+
+ @see safe_mapObjectsPerformingSelector:
+ */
+- (nonnull NSArray *)safe_mapObjectsPerformingSelector:(nonnull SEL)aSelector withObject:(nullable id)anObject;
+
 #pragma mark - Of Kind
 
 /**
@@ -193,4 +234,332 @@
  */
 - (void)safe_enumerateObjectsRespondingToSelector:(nonnull SEL)selector withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, BOOL * __nonnull stop))block;
 
-@end
\ No newline at end of file
+#pragma mark - Of Any of Several Kinds
+
+/**
+ @name Operations on objects that are a kind of any of several classes.
+ */
+
+/**
+ Executes a given block using each object in the set that is a kind of any of the given classes, in a single pass over the set.
+
+ Which of the classes an object matches is decided once per class of object, so the cost per element does not grow with the number of classes.
+
+ @param classes The classes to match objects in the set against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param block The block to apply to elements in the set.
+ The block takes two arguments:
+ obj
+ The element in the set.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the set. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes usingBlock:(nonnull void (^)(__nonnull id obj, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using each object in the set that is a kind of any of the given classes.
+
+ @param classes The classes to match objects in the set against, as an array of classes or a SafeCastClassSet. Passing the same SafeCastClassSet to repeated calls keeps its cached answers.
+
+ @param opts A bit mask that specifies the options for the enumeration.
+
+ @param block The block to apply to elements in the set.
+ */
+- (void)safe_enumerateObjectsOfKinds:(nonnull id<NSFastEnumeration>)classes withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, BOOL * __nonnull stop))block;
+
+#pragma mark - Matching a Filter
+
+/**
+ @name Operations on objects that match a SafeCastFilter.
+ */
+
+/**
+ Executes a given block using each object in the set that matches the filter.
+
+ @param filter The filter objects in the set must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param block The block to apply to elements in the set.
+ The block takes two arguments:
+ obj
+ The element in the set.
+ stop
+ A reference to a Boolean value. The block can set the value to YES to stop further processing of the set. The stop argument is an out-only argument. You should only ever set this Boolean to YES within the Block.
+ */
+- (void)safe_enumerateObjectsMatchingFilter:(nonnull SafeCastFilter *)filter usingBlock:(nonnull void (^)(__nonnull id obj, BOOL * __nonnull stop))block;
+
+/**
+ Executes a given block using each object in the set that matches the filter.
+
+ @param filter The filter objects in the set must match. Its verdict for each class of object is computed once and reused for the life of the filter.
+
+ @param opts A bit mask that specifies the options for the enumeration.
+
+ @param block The block to apply to elements in the set.
+ */
+- (void)safe_enumerateObjectsMatchingFilter:(nonnull SafeCastFilter *)filter withOptions:(NSEnumerationOptions)opts usingBlock:(nonnull void (^)(__nonnull id obj, BOOL * __nonnull stop))block;
+
+#pragma mark - Filtering
+
+/**
+ @name Filtering into a new collection
+ */
+
+/**
+ Returns the objects in the set that are of the kind of the given Class.
+
+ Elements are pulled from the set in batches and the result is built with a single allocation, without invoking any blocks.
+
+ @param class The Class objects in the set must be a kind of to be included in the result
+
+ @return A set of the objects in the set that are of the kind of the given Class. If no objects in the set pass the test, returns an empty set.
+ */
+- (nonnull NSSet *)safe_objectsOfKind:(nonnull Class)class;
+
+/**
+ Returns the objects in the set that conform to the given protocol.
+
+ Elements are pulled from the set in batches and the result is built with a single allocation, without invoking any blocks.
+
+ @param protocol The Protocol objects in the set must conform to to be included in the result
+
+ @return A set of the objects in the set that conform to the given protocol. If no objects in the set pass the test, returns an empty set.
+ */
+- (nonnull NSSet *)safe_objectsConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the objects in the set that respond to the given selector.
+
+ Elements are pulled from the set in batches and the result is built with a single allocation, without invoking any blocks.
+
+ @param selector The selector objects in the set must respond to to be included in the result
+
+ @return A set of the objects in the set that respond to the given selector. If no objects in the set pass the test, returns an empty set.
+ */
+- (nonnull NSSet *)safe_objectsRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Partitioning
+
+/**
+ @name Partitioning by kind
+ */
+
+/**
+ Splits the objects in the set into one array per class, in a single pass over the set.
+
+ Each object goes into the bucket of the first class in classes it is a kind of. Objects that are a kind of none of them go into a final, unmatched bucket. Within each bucket, objects keep the set's enumeration order. Every result array is created at its exact final size.
+
+ @param classes The classes to partition by, as an array of classes or a SafeCastClassSet.
+
+ @return An array with one array per class, in the order of classes, followed by an array of the unmatched objects. Buckets with no objects are empty arrays.
+ */
+- (nonnull NSArray *)safe_partitionObjectsByKinds:(nonnull id<NSFastEnumeration>)classes;
+
+#pragma mark - Aggregate Queries
+
+/**
+ @name Counting and finding objects without building a collection
+ */
+
+/**
+ Returns the number of objects in the set that are a kind of the given class, without allocating.
+
+ @param class The class to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsOfKind:(nonnull Class)class;
+
+/**
+ Returns one of the objects in the set that are a kind of the given class, or nil. The search stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (nullable id)safe_anyObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns YES if any of the objects in the set are a kind of the given class. The search stops at the first match.
+
+ @param class The class to test objects against.
+ */
+- (BOOL)safe_containsObjectOfKind:(nonnull Class)class;
+
+/**
+ Returns the number of objects in the set that conform to the given protocol, without allocating.
+
+ @param protocol The protocol to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns one of the objects in the set that conform to the given protocol, or nil. The search stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (nullable id)safe_anyObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns YES if any of the objects in the set conform to the given protocol. The search stops at the first match.
+
+ @param protocol The protocol to test objects against.
+ */
+- (BOOL)safe_containsObjectConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns the number of objects in the set that respond to the given selector, without allocating.
+
+ @param selector The selector to test objects against.
+ */
+- (NSUInteger)safe_countOfObjectsRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns one of the objects in the set that respond to the given selector, or nil. The search stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (nullable id)safe_anyObjectRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns YES if any of the objects in the set respond to the given selector. The search stops at the first match.
+
+ @param selector The selector to test objects against.
+ */
+- (BOOL)safe_containsObjectRespondingToSelector:(nonnull SEL)selector;
+
+#pragma mark - Enumerating with a Function
+
+/**
+ @name Enumeration with a C function instead of a block
+ */
+
+/**
+ Calls a C function for each object in the set that is a kind of the given class.
+
+ Unlike the block-based methods, no block is invoked and objects are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param class The Class objects must be a kind of for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateObjectsOfKind:(nonnull Class)class function:(nonnull SafeCastEnumerationFunction)function context:(nullable void *)context;
+
+/**
+ Calls a C function for each object in the set that conforms to the given protocol.
+
+ Unlike the block-based methods, no block is invoked and objects are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param protocol The Protocol objects must conform to for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateObjectsConformingToProtocol:(nonnull Protocol *)protocol function:(nonnull SafeCastEnumerationFunction)function context:(nullable void *)context;
+
+/**
+ Calls a C function for each object in the set that responds to the given selector.
+
+ Unlike the block-based methods, no block is invoked and objects are passed without being retained, so the cost per matching element is the test and one direct function call. This method executes synchronously.
+
+ This method raises an NSInvalidArgumentException if function is NULL.
+
+ @param selector The selector objects must respond to for the function to be called on them.
+
+ @param function The function to call. See SafeCastEnumerationFunctions.h.
+
+ @param context A pointer passed to every call of function, unchanged.
+ */
+- (void)safe_enumerateObjectsRespondingToSelector:(nonnull SEL)selector function:(nonnull SafeCastEnumerationFunction)function context:(nullable void *)context;
+
+#pragma mark - Fast Enumeration
+
+/**
+ @name Fast enumeration of objects matching a test
+ */
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects in the set that are of the kind of the given Class.
+
+ @code
+ for (MyModel *model in [set safe_fastEnumerationOfKind:[MyModel class]]) {
+     // ...
+ }
+ @endcode
+
+ Matching objects are compacted into the loop's own buffer batch by batch; no blocks are invoked and no intermediate collection is created. The returned object supports one enumeration at a time, and the set must not be mutated while it is being enumerated.
+
+ @param class The Class objects in the set must be a kind of to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationOfKind:(nonnull Class)class;
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects in the set that conform to the given protocol.
+
+ @param protocol The Protocol objects in the set must conform to to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+
+ @see safe_fastEnumerationOfKind:
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns an object for use in a for-in loop that enumerates only the objects in the set that respond to the given selector.
+
+ @param selector The selector objects in the set must respond to to be enumerated
+
+ @return An object conforming to NSFastEnumeration.
+
+ @see safe_fastEnumerationOfKind:
+ */
+- (nonnull id<NSFastEnumeration>)safe_fastEnumerationRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ Returns a lazy sequence over the objects in the set, to which filtering and mapping stages can be chained. The stages run in a single pass when a result is asked for.
+
+ @code
+ NSUInteger visible = [[[set.safe_sequence ofKind:[MyModel class]] respondingTo:@selector(draw)] count];
+ @endcode
+
+ @return A sequence over the set.
+
+ @see SafeCastSequence
+ */
+- (nonnull SafeCastSequence *)safe_sequence;
+
+@end
+
+/**
+ Type-safe compaction of an NSMutableSet.
+
+ Each method removes, in a single pass, every object that does not meet the criterion. No index sets or temporary collections are created.
+ */
+@interface NSMutableSet (SafeCast)
+
+/**
+ Removes the objects in the set that are not a kind of the given class.
+
+ @param class The class objects must be a kind of to stay in the set.
+ */
+- (void)safe_removeObjectsNotOfKind:(nonnull Class)class;
+
+/**
+ Removes the objects in the set that do not conform to the given protocol.
+
+ @param protocol The protocol objects must conform to in order to stay in the set.
+ */
+- (void)safe_removeObjectsNotConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Removes the objects in the set that do not respond to the given selector.
+
+ @param selector The selector objects must respond to in order to stay in the set.
+ */
+- (void)safe_removeObjectsNotRespondingToSelector:(nonnull SEL)selector;
+
+@end
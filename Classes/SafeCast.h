@@ -30,5 +30,10 @@
 
 #import "NSObject+SafeCast.h"
 #import "SafeCastCollections.h"
+#import "SafeCastClassSet.h"
+#import "SafeCastFilter.h"
+#import "SafeCastSequence.h"
+#import "SafeCastStreaming.h"
+#import "SafeCastTypedArray.h"
 
 #endif
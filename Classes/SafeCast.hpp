@@ -0,0 +1,191 @@
+//
+//  SafeCast.hpp
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef _SafeCast_hpp_
+#define _SafeCast_hpp_
+
+#if !defined(__cplusplus) || !defined(__OBJC__)
+#error SafeCast.hpp can only be used from Objective-C++
+#endif
+
+#import "SafeCast.h"
+
+/*
+ Typed casts and range-based for loops over SafeCast's filters, for Objective-C++.
+
+ @code
+ MyModel *model = safe_cast<MyModel>(obj);
+
+ for (MyModel *model : safe::of_kind<MyModel>(array)) {
+     [model reload];
+ }
+ @endcode
+
+ The class named by a template argument is resolved once per instantiation and kept in a function-local static. A
+ range reads matching objects in batches from the same filtering adaptor SafeCastFastEnumerationOfKind() returns, so
+ a loop costs one message per batch and the type test for each element, with no blocks.
+
+ Ranges accept any NSFastEnumeration source. Dictionaries produce their values, as the safe_fastEnumeration...
+ methods of NSDictionary do; every other source produces what a for-in loop over it would. A range supports one loop
+ at a time, and mutating the source during the loop raises, as it does in a for-in loop.
+
+ Everything lives in namespace safe; safe_cast is also brought into the global namespace.
+ */
+
+namespace safe {
+
+/**
+ Returns the class object for T, looked up the first time each instantiation is called.
+ */
+template <typename T>
+inline Class class_of()
+{
+    static Class cls = [T class];
+    return cls;
+}
+
+/**
+ Returns obj typed as T if it is an instance of T or of a subclass of T, and nil otherwise.
+ */
+template <typename T>
+inline T *safe_cast(id obj)
+{
+    return SafeCastObjectOfKind(obj, class_of<T>());
+}
+
+/**
+ A range over the objects a filtering adaptor produces, typed as Pointer. Built by of_kind(), conforming_to(),
+ responding_to() and matching(); there is normally no reason to name it.
+ */
+template <typename Pointer>
+class fast_range {
+public:
+    class iterator {
+    public:
+        explicit iterator(fast_range *range) : _range(range) {}
+        Pointer operator*() const { return _range->current(); }
+        iterator &operator++() { _range->advance(); return *this; }
+        bool operator==(const iterator &other) const { return done() == other.done(); }
+        bool operator!=(const iterator &other) const { return done() != other.done(); }
+    private:
+        bool done() const { return _range == nullptr || _range->_count == 0; }
+        fast_range *_range;
+    };
+
+    explicit fast_range(id<NSFastEnumeration> source) : _source(source), _state(), _count(0), _index(0), _mutations(0) {}
+
+    iterator begin()
+    {
+        _state = NSFastEnumerationState();
+        fetch();
+        if (_count > 0) {
+            _mutations = *_state.mutationsPtr;
+        }
+        return iterator(this);
+    }
+
+    iterator end() { return iterator(nullptr); }
+
+private:
+    static const NSUInteger batch_size = 16;
+
+    void fetch()
+    {
+        _count = [_source countByEnumeratingWithState:&_state objects:_buffer count:batch_size];
+        _index = 0;
+    }
+
+    Pointer current() const { return (Pointer)_state.itemsPtr[_index]; }
+
+    void advance()
+    {
+        if (++_index == _count) {
+            fetch();
+        }
+        if (_count > 0 && *_state.mutationsPtr != _mutations) {
+            objc_enumerationMutation(_source);
+        }
+    }
+
+    id<NSFastEnumeration> _source;
+    NSFastEnumerationState _state;
+    __unsafe_unretained id _buffer[batch_size];
+    NSUInteger _count;
+    NSUInteger _index;
+    unsigned long _mutations;
+};
+
+/**
+ Returns the source a range reads: a dictionary's values, or the source itself.
+ */
+inline id<NSFastEnumeration> range_source(id<NSFastEnumeration> source)
+{
+    if ([(id)source isKindOfClass:[NSDictionary class]]) {
+        return [(NSDictionary *)source objectEnumerator];
+    }
+    return source;
+}
+
+/**
+ Returns a range over the objects in the source that are instances of T or of a subclass of T, typed as T *.
+ */
+template <typename T>
+inline fast_range<T *> of_kind(id<NSFastEnumeration> source)
+{
+    return fast_range<T *>(SafeCastFastEnumerationOfKind(range_source(source), class_of<T>()));
+}
+
+/**
+ Returns a range over the objects in the source that conform to the protocol.
+ */
+inline fast_range<id> conforming_to(id<NSFastEnumeration> source, Protocol *protocol)
+{
+    return fast_range<id>(SafeCastFastEnumerationConformingToProtocol(range_source(source), protocol));
+}
+
+/**
+ Returns a range over the objects in the source that respond to the selector.
+ */
+inline fast_range<id> responding_to(id<NSFastEnumeration> source, SEL selector)
+{
+    return fast_range<id>(SafeCastFastEnumerationRespondingToSelector(range_source(source), selector));
+}
+
+/**
+ Returns a range over the objects in the source that match the filter.
+ */
+inline fast_range<id> matching(id<NSFastEnumeration> source, SafeCastFilter *filter)
+{
+    return fast_range<id>(SafeCastFastEnumerationMatchingFilter(range_source(source), filter));
+}
+
+} // namespace safe
+
+using safe::safe_cast;
+
+#endif
@@ -0,0 +1,130 @@
+//
+//  SafeCastAggregates.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Aggregate queries walk the collection without blocks or result collections, and stop at the first match where they can.
+// Dictionaries are walked with a block on the stack, so state the block writes to is __block.
+
+#undef SAFE_CAST_AGGREGATE_STORAGE
+#undef SAFE_CAST_AGGREGATE_BEGIN
+#undef SAFE_CAST_AGGREGATE_BREAK
+#undef SAFE_CAST_AGGREGATE_END
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_AGGREGATE_STORAGE __block
+#define SAFE_CAST_AGGREGATE_BEGIN [self enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+#define SAFE_CAST_AGGREGATE_BREAK {*stop = YES; return;}
+#define SAFE_CAST_AGGREGATE_END }];
+#else
+#define SAFE_CAST_AGGREGATE_STORAGE
+#define SAFE_CAST_AGGREGATE_BEGIN SAFE_CAST_BATCH_BEGIN(self, obj)
+#define SAFE_CAST_AGGREGATE_BREAK SAFE_CAST_BATCH_BREAK
+#define SAFE_CAST_AGGREGATE_END SAFE_CAST_BATCH_END
+#endif
+
+#undef SAFE_CAST_COUNT
+#define SAFE_CAST_COUNT(criterion) -(NSUInteger)safe_countOfObjects ## criterion {\
+SAFE_CAST_TEST_SETUP \
+SAFE_CAST_AGGREGATE_STORAGE NSUInteger count = 0;\
+SAFE_CAST_AGGREGATE_BEGIN \
+if SAFE_CAST_TEST {count++;}\
+SAFE_CAST_AGGREGATE_END \
+return count;}
+
+#undef SAFE_CAST_FIRST
+#define SAFE_CAST_FIRST(name, criterion) -(id)safe_ ## name ## criterion {\
+SAFE_CAST_TEST_SETUP \
+SAFE_CAST_AGGREGATE_STORAGE __unsafe_unretained id match = nil;\
+SAFE_CAST_AGGREGATE_BEGIN \
+if SAFE_CAST_TEST {match = obj; SAFE_CAST_AGGREGATE_BREAK}\
+SAFE_CAST_AGGREGATE_END \
+return match;}
+
+#undef SAFE_CAST_CONTAINS
+#define SAFE_CAST_CONTAINS(criterion, first) -(BOOL)safe_containsObject ## criterion {\
+return [self first] != nil;}
+
+// Ordered collections are walked from the end in batches copied out with -getObjects:range:.
+#undef SAFE_CAST_LAST
+#define SAFE_CAST_LAST(criterion) -(id)safe_lastObject ## criterion {\
+SAFE_CAST_TEST_SETUP \
+__unsafe_unretained id objects[SAFE_CAST_BATCH_SIZE];\
+NSUInteger end = self.count;\
+while (end > 0) {\
+NSUInteger length = MIN((NSUInteger)SAFE_CAST_BATCH_SIZE, end);\
+[self getObjects:objects range:NSMakeRange(end - length, length)];\
+for (NSUInteger i = length; i > 0; i--) {\
+__unsafe_unretained id obj = objects[i - 1];\
+if SAFE_CAST_TEST {return obj;}}\
+end -= length;}\
+return nil;}
+
+#pragma mark - Kind of Class
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_COUNT(OfKind:(Class)class)
+#ifdef SAFE_CAST_ORDERED_AGGREGATES
+SAFE_CAST_FIRST(firstObject, OfKind:(Class)class)
+SAFE_CAST_LAST(OfKind:(Class)class)
+SAFE_CAST_CONTAINS(OfKind:(Class)class, safe_firstObjectOfKind:class)
+#else
+SAFE_CAST_FIRST(anyObject, OfKind:(Class)class)
+SAFE_CAST_CONTAINS(OfKind:(Class)class, safe_anyObjectOfKind:class)
+#endif
+
+#pragma mark - Protocols
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_COUNT(ConformingToProtocol:(Protocol *)protocol)
+#ifdef SAFE_CAST_ORDERED_AGGREGATES
+SAFE_CAST_FIRST(firstObject, ConformingToProtocol:(Protocol *)protocol)
+SAFE_CAST_LAST(ConformingToProtocol:(Protocol *)protocol)
+SAFE_CAST_CONTAINS(ConformingToProtocol:(Protocol *)protocol, safe_firstObjectConformingToProtocol:protocol)
+#else
+SAFE_CAST_FIRST(anyObject, ConformingToProtocol:(Protocol *)protocol)
+SAFE_CAST_CONTAINS(ConformingToProtocol:(Protocol *)protocol, safe_anyObjectConformingToProtocol:protocol)
+#endif
+
+#pragma mark - Selectors
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SAFE_CAST_AGGREGATE_STORAGE SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_COUNT(RespondingToSelector:(SEL)selector)
+#ifdef SAFE_CAST_ORDERED_AGGREGATES
+SAFE_CAST_FIRST(firstObject, RespondingToSelector:(SEL)selector)
+SAFE_CAST_LAST(RespondingToSelector:(SEL)selector)
+SAFE_CAST_CONTAINS(RespondingToSelector:(SEL)selector, safe_firstObjectRespondingToSelector:selector)
+#else
+SAFE_CAST_FIRST(anyObject, RespondingToSelector:(SEL)selector)
+SAFE_CAST_CONTAINS(RespondingToSelector:(SEL)selector, safe_anyObjectRespondingToSelector:selector)
+#endif
+
+#undef SAFE_CAST_TEST_SETUP
@@ -0,0 +1,167 @@
+//
+//  SafeCastBatch.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <objc/runtime.h>
+
+/*
+ Building blocks for walking collections in batches without blocks.
+
+ SAFE_CAST_BATCH_BEGIN / SAFE_CAST_BATCH_END bracket a loop body that runs once per element of any NSFastEnumeration collection, with `obj` bound to an unretained reference to the element and SAFE_CAST_BATCH_INDEX to its position in enumeration order. Elements are pulled with -countByEnumeratingWithState:objects:count:, mutation of the collection raises exactly as it does in a for-in loop, and SAFE_CAST_BATCH_BREAK leaves the whole loop.
+
+ SAFE_CAST_RANGE_BEGIN / SAFE_CAST_RANGE_END do the same for a range of an indexed collection (NSArray or NSOrderedSet), forwards or backwards, with SAFE_CAST_RANGE_INDEX bound to the element's index and SAFE_CAST_RANGE_BREAK leaving the loop. Elements are copied out in batches with -getObjects:range:, and mutation raises as above.
+
+ SafeCastObjectBuffer accumulates unretained object pointers, starting on the stack and spilling to the heap only for large results. It is meant for pointers that are kept alive by the collection being walked. Callers that will fill the buffer with exactly a known number of objects, such as every entry of a dictionary, size it up front so that appending never reallocates. Callers collecting matches, whose number is only bounded by the count of the collection, start on the stack and let the buffer grow, so a large collection with few matches does not pay for a buffer of its full size. A failed allocation raises NSMallocException.
+ */
+
+#define SAFE_CAST_BATCH_SIZE 64
+
+#define SAFE_CAST_BATCH_BEGIN(collection, obj) {\
+NSFastEnumerationState safeCastState = {0};\
+__unsafe_unretained id safeCastBatch[SAFE_CAST_BATCH_SIZE];\
+NSUInteger safeCastBatchCount = 0;\
+NSUInteger safeCastIndex = 0;\
+unsigned long safeCastMutations = 0;\
+BOOL safeCastDone = NO;\
+while (!safeCastDone && (safeCastBatchCount = [collection countByEnumeratingWithState:&safeCastState objects:safeCastBatch count:SAFE_CAST_BATCH_SIZE]) > 0) {\
+if (safeCastIndex == 0) {safeCastMutations = *safeCastState.mutationsPtr;}\
+for (NSUInteger safeCastI = 0; !safeCastDone && safeCastI < safeCastBatchCount; safeCastI++, safeCastIndex++) {\
+if (*safeCastState.mutationsPtr != safeCastMutations) {objc_enumerationMutation(collection);}\
+__unsafe_unretained id obj = safeCastState.itemsPtr[safeCastI];
+
+#define SAFE_CAST_BATCH_END }}}
+
+#define SAFE_CAST_BATCH_INDEX safeCastIndex
+
+#define SAFE_CAST_BATCH_BREAK {safeCastDone = YES; continue;}
+
+/**
+ Returns the mutation counter fast enumeration would check for the collection, or a counter that never changes if the collection is empty. The state must outlive every use of the returned pointer.
+ */
+static inline unsigned long *SafeCastMutationsPointer(id<NSFastEnumeration> collection, NSFastEnumerationState *state)
+{
+    static unsigned long unchanging = 0;
+    __unsafe_unretained id probe[1];
+    if ([collection countByEnumeratingWithState:state objects:probe count:1] == 0) {
+        return &unchanging;
+    }
+    return state->mutationsPtr;
+}
+
+#define SAFE_CAST_RANGE_BEGIN(collection, range, reverse, obj) {\
+NSFastEnumerationState safeCastState = {0};\
+unsigned long *safeCastMutationsPtr = SafeCastMutationsPointer(collection, &safeCastState);\
+unsigned long safeCastMutations = *safeCastMutationsPtr;\
+__unsafe_unretained id safeCastBatch[SAFE_CAST_BATCH_SIZE];\
+NSRange safeCastRange = (range);\
+BOOL safeCastReverse = (reverse);\
+NSUInteger safeCastRemaining = safeCastRange.length;\
+BOOL safeCastDone = NO;\
+while (!safeCastDone && safeCastRemaining > 0) {\
+NSUInteger safeCastLength = MIN((NSUInteger)SAFE_CAST_BATCH_SIZE, safeCastRemaining);\
+NSUInteger safeCastLocation = safeCastReverse ? safeCastRange.location + safeCastRemaining - safeCastLength : NSMaxRange(safeCastRange) - safeCastRemaining;\
+[collection getObjects:safeCastBatch range:NSMakeRange(safeCastLocation, safeCastLength)];\
+safeCastRemaining -= safeCastLength;\
+for (NSUInteger safeCastI = 0; !safeCastDone && safeCastI < safeCastLength; safeCastI++) {\
+if (*safeCastMutationsPtr != safeCastMutations) {objc_enumerationMutation(collection);}\
+NSUInteger safeCastOffset = safeCastReverse ? safeCastLength - 1 - safeCastI : safeCastI;\
+__unsafe_unretained id obj = safeCastBatch[safeCastOffset];
+
+#define SAFE_CAST_RANGE_END }}}
+
+#define SAFE_CAST_RANGE_INDEX (safeCastLocation + safeCastOffset)
+
+#define SAFE_CAST_RANGE_BREAK {safeCastDone = YES; continue;}
+
+#define SAFE_CAST_OBJECT_BUFFER_STACK_SIZE 256
+
+typedef struct SafeCastObjectBuffer {
+    __unsafe_unretained id *objects;
+    NSUInteger count;
+    NSUInteger capacity;
+    __unsafe_unretained id stack[SAFE_CAST_OBJECT_BUFFER_STACK_SIZE];
+} SafeCastObjectBuffer;
+
+static inline void SafeCastObjectBufferAllocationFailed(NSUInteger capacity)
+{
+    [NSException raise:NSMallocException format:@"SafeCast could not allocate a buffer for %lu objects", (unsigned long)capacity];
+}
+
+static inline void SafeCastObjectBufferInitWithCapacity(SafeCastObjectBuffer *buffer, NSUInteger capacity)
+{
+    buffer->count = 0;
+    if (capacity <= SAFE_CAST_OBJECT_BUFFER_STACK_SIZE) {
+        buffer->objects = buffer->stack;
+        buffer->capacity = SAFE_CAST_OBJECT_BUFFER_STACK_SIZE;
+    } else {
+        buffer->objects = (__unsafe_unretained id *)malloc(capacity * sizeof(id));
+        if (buffer->objects == NULL) {
+            buffer->objects = buffer->stack;
+            buffer->capacity = SAFE_CAST_OBJECT_BUFFER_STACK_SIZE;
+            SafeCastObjectBufferAllocationFailed(capacity);
+        }
+        buffer->capacity = capacity;
+    }
+}
+
+static inline void SafeCastObjectBufferInit(SafeCastObjectBuffer *buffer)
+{
+    SafeCastObjectBufferInitWithCapacity(buffer, 0);
+}
+
+// Buffers sized up front for an exact count never grow; only results of unknown size take this path.
+static inline void SafeCastObjectBufferAppend(SafeCastObjectBuffer *buffer, __unsafe_unretained id obj)
+{
+    if (buffer->count == buffer->capacity) {
+        NSUInteger capacity = buffer->capacity * 2;
+        __unsafe_unretained id *objects;
+        if (buffer->objects == buffer->stack) {
+            objects = (__unsafe_unretained id *)malloc(capacity * sizeof(id));
+            if (objects != NULL) {
+                memcpy((void *)objects, (const void *)buffer->stack, buffer->count * sizeof(id));
+            }
+        } else {
+            objects = (__unsafe_unretained id *)realloc((void *)buffer->objects, capacity * sizeof(id));
+        }
+        if (objects == NULL) {
+            // The old allocation is still valid and still owned by the buffer, so SafeCastObjectBufferFree releases it.
+            SafeCastObjectBufferAllocationFailed(capacity);
+        }
+        buffer->objects = objects;
+        buffer->capacity = capacity;
+    }
+    buffer->objects[buffer->count++] = obj;
+}
+
+static inline void SafeCastObjectBufferFree(SafeCastObjectBuffer *buffer)
+{
+    if (buffer->objects != buffer->stack) {
+        free((void *)buffer->objects);
+    }
+    buffer->objects = NULL;
+    buffer->count = 0;
+}
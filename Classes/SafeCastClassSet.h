@@ -0,0 +1,70 @@
+//
+//  SafeCastClassSet.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ An immutable, ordered set of classes that answers whether an object is a kind of any of them.
+
+ The answer for a given class of object is computed once, by asking the object against each class in order, and remembered for the life of the set. After that, membership for any object of that class is a single hash lookup regardless of how many classes the set holds. Classes that override -isKindOfClass: are always asked directly.
+
+ A class set is safe to use from multiple threads at once. Build one up front and reuse it to keep its answers across calls.
+
+ Enumerating a class set enumerates its classes, so a class set can be passed anywhere an array of classes is accepted.
+ */
+@interface SafeCastClassSet : NSObject <NSCopying, NSFastEnumeration>
+
+/**
+ Returns a class set containing the given classes.
+
+ @param classes The classes to test objects against, in order of precedence. Each element must be a Class.
+ */
++ (nonnull instancetype)classSetWithClasses:(nonnull id<NSFastEnumeration>)classes;
+
+/**
+ Initializes a class set containing the given classes.
+
+ @param classes The classes to test objects against, in order of precedence. Each element must be a Class.
+ */
+- (nonnull instancetype)initWithClasses:(nonnull id<NSFastEnumeration>)classes;
+
+/**
+ The classes in the set, in the order they were given.
+ */
+@property (nonatomic, readonly, copy, nonnull) NSArray *classes;
+
+/**
+ Returns YES if the object is an instance of any class in the set, or of a subclass of one.
+ */
+- (BOOL)containsKindOfObject:(nullable id)obj;
+
+/**
+ Returns the index in classes of the first class the object is a kind of, or NSNotFound if there is none.
+ */
+- (NSUInteger)indexOfKindOfObject:(nullable id)obj;
+
+@end
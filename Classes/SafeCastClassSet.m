@@ -0,0 +1,162 @@
+//
+//  SafeCastClassSet.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastClassSet.h"
+#import "SafeCastDecisionCache.h"
+
+#define SAFE_CAST_CLASS_SET_CAPACITY 256
+
+// Verdicts in a class set's table are the index of the first matching class, NSNotFound, or this.
+static const uintptr_t SafeCastClassSetAskObject = UINTPTR_MAX;
+
+static void SafeCastRaiseAllocationFailure(id object)
+{
+    [NSException raise:NSMallocException format:@"%@ could not allocate its lookup tables", NSStringFromClass([object class])];
+}
+
+@implementation SafeCastClassSet {
+    __unsafe_unretained Class *_classList;
+    NSUInteger _classCount;
+    _Atomic(SafeCastDecision *) *_slots;
+    SafeCastDecisionTable _table;
+}
+
++ (instancetype)classSetWithClasses:(id<NSFastEnumeration>)classes
+{
+    return [[self alloc] initWithClasses:classes];
+}
+
+- (instancetype)init
+{
+    return [self initWithClasses:@[]];
+}
+
+- (instancetype)initWithClasses:(id<NSFastEnumeration>)classes
+{
+    self = [super init];
+    if (self == nil) {
+        return nil;
+    }
+
+    NSMutableArray *classArray = [NSMutableArray array];
+    for (Class cls in classes) {
+        [classArray addObject:cls];
+    }
+    _classes = [classArray copy];
+    _classCount = _classes.count;
+    _classList = (__unsafe_unretained Class *)calloc(MAX(_classCount, (NSUInteger)1), sizeof(Class));
+    if (_classList == NULL) {
+        SafeCastRaiseAllocationFailure(self);
+    }
+    for (NSUInteger i = 0; i < _classCount; i++) {
+        _classList[i] = _classes[i];
+    }
+
+    _slots = calloc(SAFE_CAST_CLASS_SET_CAPACITY, sizeof(*_slots));
+    if (_slots == NULL) {
+        SafeCastRaiseAllocationFailure(self);
+    }
+    _table.slots = _slots;
+    _table.mask = SAFE_CAST_CLASS_SET_CAPACITY - 1;
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_slots != NULL) {
+        for (NSUInteger i = 0; i < SAFE_CAST_CLASS_SET_CAPACITY; i++) {
+            free(atomic_load_explicit(&_slots[i], memory_order_relaxed));
+        }
+    }
+    free(_slots);
+    free(_classList);
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+    return [_classes countByEnumeratingWithState:state objects:buffer count:len];
+}
+
+- (BOOL)containsKindOfObject:(id)obj
+{
+    return SafeCastClassSetIndexOfObject(self, obj) != NSNotFound;
+}
+
+- (NSUInteger)indexOfKindOfObject:(id)obj
+{
+    return SafeCastClassSetIndexOfObject(self, obj);
+}
+
+static NSUInteger SafeCastClassSetAskEachClass(SafeCastClassSet *set, id obj)
+{
+    for (NSUInteger i = 0; i < set->_classCount; i++) {
+        if ([obj isKindOfClass:set->_classList[i]]) {
+            return i;
+        }
+    }
+    return NSNotFound;
+}
+
+NSUInteger SafeCastClassSetIndexOfObject(SafeCastClassSet *set, id obj)
+{
+    if (obj == nil) {
+        return NSNotFound;
+    }
+
+    Class cls = object_getClass(obj);
+    const void *key = (__bridge const void *)cls;
+    uintptr_t verdict;
+
+    if (!SafeCastDecisionTableLookup(&set->_table, key, NULL, &verdict)) {
+        if (SafeCastClassUsesRootImplementation(cls, @selector(isKindOfClass:))) {
+            verdict = SafeCastClassSetAskEachClass(set, obj);
+        } else {
+            verdict = SafeCastClassSetAskObject;
+        }
+        SafeCastDecisionTableInsert(&set->_table, key, NULL, verdict);
+    }
+
+    if (verdict == SafeCastClassSetAskObject) {
+        return SafeCastClassSetAskEachClass(set, obj);
+    }
+    return (NSUInteger)verdict;
+}
+
+SafeCastClassSet *SafeCastClassSetWithClasses(id<NSFastEnumeration> classes)
+{
+    if ([(id)classes isKindOfClass:[SafeCastClassSet class]]) {
+        return (SafeCastClassSet *)classes;
+    }
+    return [SafeCastClassSet classSetWithClasses:classes];
+}
+
+@end
@@ -25,17 +25,32 @@
 //  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#if defined(GNUSTEP)
+#import <Foundation/Foundation.h>
+#else
 #import <Availability.h>
+#endif
+
+#ifndef DEPRECATED_ATTRIBUTE
+#define DEPRECATED_ATTRIBUTE __attribute__((deprecated))
+#endif
 
-#if ( ( defined(__MAC_OS_X_VERSION_MAX_ALLOWED) && __MAC_OS_X_VERSION_MAX_ALLOWED >= __MAC_10_6) || \
-( defined(__IPHONE_OS_VERSION_MAX_ALLOWED) && __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_4_0 ) )
+// The collection categories use -[NSDictionary getObjects:andKeys:count:] and NSOrderedSet, which first shipped in
+// OS X 10.7 and iOS 5.0, the deployment targets in SafeCast.podspec.
+#if ( defined(GNUSTEP) || \
+( defined(__MAC_OS_X_VERSION_MAX_ALLOWED) && __MAC_OS_X_VERSION_MAX_ALLOWED >= __MAC_10_7) || \
+( defined(__IPHONE_OS_VERSION_MAX_ALLOWED) && __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_5_0 ) )
 #import "NSArray+SafeCast.h"
 #import "NSSet+SafeCast.h"
 #import "NSDictionary+SafeCast.h"
+#import "NSOrderedSet+SafeCast.h"
 #endif
 
-#if ( ( defined(__MAC_OS_X_VERSION_MAX_ALLOWED) && __MAC_OS_X_VERSION_MAX_ALLOWED >= __MAC_10_7) || \
-( defined(__IPHONE_OS_VERSION_MAX_ALLOWED) && __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_5_0 ) )
-#import "NSOrderedSet+SafeCast.h"
+#if ( defined(GNUSTEP) || \
+( defined(__MAC_OS_X_VERSION_MAX_ALLOWED) && __MAC_OS_X_VERSION_MAX_ALLOWED >= __MAC_10_8) || \
+( defined(__IPHONE_OS_VERSION_MAX_ALLOWED) && __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_6_0 ) )
+#import "NSHashTable+SafeCast.h"
+#import "NSMapTable+SafeCast.h"
+#import "NSPointerArray+SafeCast.h"
 #endif
 
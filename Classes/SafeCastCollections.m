@@ -26,6 +26,15 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "SafeCastCollections.h"
+#import "SafeCastClassSet.h"
+#import "SafeCastFilter.h"
+#import "SafeCastDecisionCache.h"
+#import "SafeCastBatch.h"
+#import "SafeCastIndexSetBuilder.h"
+#import "SafeCastFastEnumeration.h"
+#import "SafeCastConcurrency.h"
+#import "SafeCastLazyCollection.h"
+#import "SafeCastSequence.h"
 
 @implementation NSArray (SafeCast)
 
@@ -35,17 +44,68 @@
 #undef SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS
 #define SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS obj,idx,stop
 
+#undef SAFE_CAST_ENUMERATE_FUNCTION_TYPE
+#define SAFE_CAST_ENUMERATE_FUNCTION_TYPE SafeCastIndexedEnumerationFunction
+
+#undef SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS
+#define SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS obj, SAFE_CAST_BATCH_INDEX, &stop
+
+#undef SAFE_CAST_ENUMERATE_FUNCTION_ARGUMENTS
+#define SAFE_CAST_ENUMERATE_FUNCTION_ARGUMENTS SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS, context
+
+#define SAFE_CAST_ORDERED_ENUMERATION 1
+
 #include "SafeCastPerformSelector.h"
+#include "SafeCastSelectorMapping.h"
 #include "SafeCastEnumeration.h"
+#include "SafeCastFunctionEnumeration.h"
 #include "SafeCastIndexedEnumeration.h"
 #include "SafeCastIndexedEnumerationDeprecatedSupport.h"
+#include "SafeCastConcurrentEnumeration.h"
+#include "SafeCastReduction.h"
+
+#undef SAFE_CAST_FILTER_RESULT_CLASS
+#define SAFE_CAST_FILTER_RESULT_CLASS NSArray
+#undef SAFE_CAST_FILTER_RESULT_FACTORY
+#define SAFE_CAST_FILTER_RESULT_FACTORY arrayWithObjects
+
+#include "SafeCastFiltering.h"
+#include "SafeCastFastEnumerationAdaptors.h"
+#include "SafeCastPartition.h"
+
+#define SAFE_CAST_ORDERED_AGGREGATES 1
+#include "SafeCastAggregates.h"
+
+#define SAFE_CAST_LAZY_VIEW_NAME lazyArray
+#define SAFE_CAST_LAZY_VIEW_CLASS SafeCastLazyArray
+#include "SafeCastLazyViews.h"
 @end
 
 @implementation NSOrderedSet (SafeCast)
 
+#include "SafeCastSelectorMapping.h"
 #include "SafeCastEnumeration.h"
+#include "SafeCastFunctionEnumeration.h"
 #include "SafeCastIndexedEnumeration.h"
 #include "SafeCastIndexedEnumerationDeprecatedSupport.h"
+#include "SafeCastConcurrentEnumeration.h"
+#include "SafeCastReduction.h"
+
+#undef SAFE_CAST_FILTER_RESULT_CLASS
+#define SAFE_CAST_FILTER_RESULT_CLASS NSOrderedSet
+#undef SAFE_CAST_FILTER_RESULT_FACTORY
+#define SAFE_CAST_FILTER_RESULT_FACTORY orderedSetWithObjects
+
+#include "SafeCastFiltering.h"
+#include "SafeCastFastEnumerationAdaptors.h"
+#include "SafeCastPartition.h"
+#include "SafeCastAggregates.h"
+
+#undef SAFE_CAST_LAZY_VIEW_NAME
+#define SAFE_CAST_LAZY_VIEW_NAME lazyOrderedSet
+#undef SAFE_CAST_LAZY_VIEW_CLASS
+#define SAFE_CAST_LAZY_VIEW_CLASS SafeCastLazyOrderedSet
+#include "SafeCastLazyViews.h"
 
 @end
 
@@ -57,8 +117,33 @@
 #undef SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS
 #define SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS obj,stop
 
+#undef SAFE_CAST_ENUMERATE_FUNCTION_TYPE
+#define SAFE_CAST_ENUMERATE_FUNCTION_TYPE SafeCastEnumerationFunction
+
+#undef SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS
+#define SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS obj, &stop
+
+#undef SAFE_CAST_ENUMERATE_FUNCTION_ARGUMENTS
+#define SAFE_CAST_ENUMERATE_FUNCTION_ARGUMENTS SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS, context
+
+#undef SAFE_CAST_ORDERED_ENUMERATION
+
 #include "SafeCastPerformSelector.h"
+#include "SafeCastSelectorMapping.h"
 #include "SafeCastEnumeration.h"
+#include "SafeCastFunctionEnumeration.h"
+
+#undef SAFE_CAST_FILTER_RESULT_CLASS
+#define SAFE_CAST_FILTER_RESULT_CLASS NSSet
+#undef SAFE_CAST_FILTER_RESULT_FACTORY
+#define SAFE_CAST_FILTER_RESULT_FACTORY setWithObjects
+
+#include "SafeCastFiltering.h"
+#include "SafeCastFastEnumerationAdaptors.h"
+#include "SafeCastPartition.h"
+
+#undef SAFE_CAST_ORDERED_AGGREGATES
+#include "SafeCastAggregates.h"
 @end
 
 @implementation NSDictionary (SafeCast)
@@ -71,6 +156,73 @@
 #undef SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS
 #define SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS key,obj,stop
 
+#undef SAFE_CAST_ENUMERATE_FUNCTION_TYPE
+#define SAFE_CAST_ENUMERATE_FUNCTION_TYPE SafeCastKeyedEnumerationFunction
+
 #include "SafeCastEnumeration.h"
+#include "SafeCastFunctionEnumeration.h"
+#include "SafeCastFiltering.h"
+#include "SafeCastFastEnumerationAdaptors.h"
+#include "SafeCastAggregates.h"
+
+@end
+
+@implementation NSMutableArray (SafeCast)
+
+#undef SAFE_CAST_COMPACTION
+#define SAFE_CAST_COMPACTION SAFE_CAST_COMPACTION_IN_PLACE
+#include "SafeCastCompaction.h"
+
+@end
+
+@implementation NSMutableOrderedSet (SafeCast)
+
+#undef SAFE_CAST_COMPACTION
+#define SAFE_CAST_COMPACTION SAFE_CAST_COMPACTION_EXCHANGE
+#include "SafeCastCompaction.h"
+
+@end
+
+@implementation NSMutableSet (SafeCast)
+
+#undef SAFE_CAST_COMPACTION
+#define SAFE_CAST_COMPACTION SAFE_CAST_COMPACTION_REMOVE_OBJECTS
+#include "SafeCastCompaction.h"
+
+@end
+
+@implementation NSMutableDictionary (SafeCast)
+
+#undef SAFE_CAST_COMPACTION
+#define SAFE_CAST_COMPACTION SAFE_CAST_COMPACTION_REMOVE_KEYS
+#include "SafeCastCompaction.h"
+
+@end
+
+#if ( defined(GNUSTEP) || \
+( defined(__MAC_OS_X_VERSION_MAX_ALLOWED) && __MAC_OS_X_VERSION_MAX_ALLOWED >= __MAC_10_8) || \
+( defined(__IPHONE_OS_VERSION_MAX_ALLOWED) && __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_6_0 ) )
+
+#undef SAFE_CAST_KEYED_ENUMERATION
+
+@implementation NSHashTable (SafeCast)
+
+#include "SafeCastLiveEnumeration.h"
 
 @end
+
+@implementation NSPointerArray (SafeCast)
+
+#include "SafeCastLiveEnumeration.h"
+
+@end
+
+#define SAFE_CAST_KEYED_ENUMERATION 1
+
+@implementation NSMapTable (SafeCast)
+
+#include "SafeCastLiveEnumeration.h"
+
+@end
+
+#endif
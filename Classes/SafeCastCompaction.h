@@ -0,0 +1,114 @@
+//
+//  SafeCastCompaction.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Compaction removes every object that fails the test in one pass, without building index sets.
+// How objects are removed depends on the collection, selected by SAFE_CAST_COMPACTION.
+
+#define SAFE_CAST_COMPACTION_IN_PLACE 1
+#define SAFE_CAST_COMPACTION_EXCHANGE 2
+#define SAFE_CAST_COMPACTION_REMOVE_OBJECTS 3
+#define SAFE_CAST_COMPACTION_REMOVE_KEYS 4
+
+#undef SAFE_CAST_REMOVE
+#if SAFE_CAST_COMPACTION == SAFE_CAST_COMPACTION_IN_PLACE
+// Survivors slide down over discarded slots, then the tail is cut off with a single range removal.
+#define SAFE_CAST_REMOVE(criterion) -(void)safe_removeObjectsNot ## criterion {\
+SAFE_CAST_TEST_SETUP \
+NSUInteger count = self.count;\
+NSUInteger kept = 0;\
+for (NSUInteger i = 0; i < count; i++) {\
+id obj = [self objectAtIndex:i];\
+if SAFE_CAST_TEST {\
+if (kept != i) {[self replaceObjectAtIndex:kept withObject:obj];}\
+kept++;}}\
+if (kept < count) {[self removeObjectsInRange:NSMakeRange(kept, count - kept)];}}
+#elif SAFE_CAST_COMPACTION == SAFE_CAST_COMPACTION_EXCHANGE
+// An ordered set cannot hold an object twice, even briefly, so survivors are swapped forward with the discarded object
+// in their way instead of copied over it. Survivors keep their order and the discarded objects collect in the tail,
+// which is cut off with a single range removal.
+#define SAFE_CAST_REMOVE(criterion) -(void)safe_removeObjectsNot ## criterion {\
+SAFE_CAST_TEST_SETUP \
+NSUInteger count = self.count;\
+NSUInteger kept = 0;\
+for (NSUInteger i = 0; i < count; i++) {\
+id obj = [self objectAtIndex:i];\
+if SAFE_CAST_TEST {\
+if (kept != i) {[self exchangeObjectAtIndex:kept withObjectAtIndex:i];}\
+kept++;}}\
+if (kept < count) {[self removeObjectsInRange:NSMakeRange(kept, count - kept)];}}
+#elif SAFE_CAST_COMPACTION == SAFE_CAST_COMPACTION_REMOVE_OBJECTS
+// Discarded objects are gathered unretained while the set still owns them, then removed in one call on a set that
+// retains them, so none is deallocated while it is still being used as an argument.
+#define SAFE_CAST_REMOVE(criterion) -(void)safe_removeObjectsNot ## criterion {\
+SAFE_CAST_TEST_SETUP \
+SafeCastObjectBuffer discarded;\
+SafeCastObjectBufferInit(&discarded);\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if (!SAFE_CAST_TEST) {SafeCastObjectBufferAppend(&discarded, obj);}\
+SAFE_CAST_BATCH_END\
+if (discarded.count > 0) {[self minusSet:[NSSet setWithObjects:discarded.objects count:discarded.count]];}\
+SafeCastObjectBufferFree(&discarded);}
+#elif SAFE_CAST_COMPACTION == SAFE_CAST_COMPACTION_REMOVE_KEYS
+#define SAFE_CAST_REMOVE(criterion) -(void)safe_removeObjectsNot ## criterion {\
+SAFE_CAST_TEST_SETUP \
+NSUInteger count = self.count;\
+SafeCastObjectBuffer keys, objects;\
+SafeCastObjectBufferInitWithCapacity(&keys, count);\
+SafeCastObjectBufferInitWithCapacity(&objects, count);\
+[self getObjects:objects.objects andKeys:keys.objects count:count];\
+NSUInteger discarded = 0;\
+for (NSUInteger i = 0; i < count; i++) {\
+__unsafe_unretained id obj = objects.objects[i];\
+if (!SAFE_CAST_TEST) {keys.objects[discarded++] = keys.objects[i];}}\
+if (discarded > 0) {[self removeObjectsForKeys:[NSArray arrayWithObjects:keys.objects count:discarded]];}\
+SafeCastObjectBufferFree(&keys);\
+SafeCastObjectBufferFree(&objects);}
+#endif
+
+#pragma mark - Kind of Class
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_REMOVE(OfKind:(Class)class)
+
+#pragma mark - Protocols
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_REMOVE(ConformingToProtocol:(Protocol *)protocol)
+
+#pragma mark - Selectors
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_REMOVE(RespondingToSelector:(SEL)selector)
+
+#undef SAFE_CAST_TEST_SETUP
@@ -0,0 +1,57 @@
+//
+//  SafeCastConcurrency.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <dispatch/dispatch.h>
+#import <stdatomic.h>
+
+/*
+ A chunked parallel-for for indexed collections.
+
+ The index range [0, count) is split into contiguous chunks of grainSize indexes. One worker per available processor (never more than there are chunks) is started with dispatch_apply, and each worker repeatedly claims the next unclaimed chunk with an atomic increment, so fast workers pick up the slack of slow ones. Every chunk costs one block invocation; what happens to the elements inside it is up to the body.
+
+ The body receives a shared stop flag. Setting it prevents any further chunks from being claimed, and bodies should check it between elements so that running chunks wind down promptly.
+ */
+
+typedef _Atomic(BOOL) SafeCastStopFlag;
+
+/**
+ The grain size used when 0 is passed to SafeCastApplyChunks().
+ */
+FOUNDATION_EXTERN NSUInteger SafeCastDefaultGrainSize(NSUInteger count, NSUInteger workerCount);
+
+FOUNDATION_EXTERN void SafeCastApplyChunks(NSUInteger count, NSUInteger grainSize, void (^body)(NSRange range, SafeCastStopFlag *stop));
+
+static inline BOOL SafeCastShouldStop(SafeCastStopFlag *stop)
+{
+    return atomic_load_explicit(stop, memory_order_relaxed);
+}
+
+static inline void SafeCastStop(SafeCastStopFlag *stop)
+{
+    atomic_store_explicit(stop, YES, memory_order_relaxed);
+}
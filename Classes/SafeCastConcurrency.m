@@ -0,0 +1,75 @@
+//
+//  SafeCastConcurrency.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastConcurrency.h"
+
+#define SAFE_CAST_MINIMUM_GRAIN_SIZE 1024
+#define SAFE_CAST_CHUNKS_PER_WORKER 8
+
+NSUInteger SafeCastDefaultGrainSize(NSUInteger count, NSUInteger workerCount)
+{
+    return MAX((NSUInteger)SAFE_CAST_MINIMUM_GRAIN_SIZE, count / (MAX(workerCount, (NSUInteger)1) * SAFE_CAST_CHUNKS_PER_WORKER));
+}
+
+void SafeCastApplyChunks(NSUInteger count, NSUInteger grainSize, void (^body)(NSRange range, SafeCastStopFlag *stop))
+{
+    if (count == 0) {
+        return;
+    }
+
+    NSUInteger processorCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    if (grainSize == 0) {
+        grainSize = SafeCastDefaultGrainSize(count, processorCount);
+    }
+
+    NSUInteger chunkCount = count / grainSize + (count % grainSize ? 1 : 0);
+    NSUInteger workerCount = MIN(chunkCount, processorCount);
+
+    SafeCastStopFlag stopFlag = NO;
+    SafeCastStopFlag *stop = &stopFlag;
+
+    if (workerCount <= 1) {
+        for (NSUInteger location = 0; location < count && !SafeCastShouldStop(stop); location += grainSize) {
+            body(NSMakeRange(location, MIN(grainSize, count - location)), stop);
+        }
+        return;
+    }
+
+    _Atomic(NSUInteger) nextChunk = 0;
+    _Atomic(NSUInteger) *next = &nextChunk;
+
+    dispatch_apply(workerCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t worker) {
+        for (;;) {
+            NSUInteger chunk = atomic_fetch_add_explicit(next, 1, memory_order_relaxed);
+            if (chunk >= chunkCount || SafeCastShouldStop(stop)) {
+                return;
+            }
+            NSUInteger location = chunk * grainSize;
+            body(NSMakeRange(location, MIN(grainSize, count - location)), stop);
+        }
+    });
+}
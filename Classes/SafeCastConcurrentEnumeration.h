@@ -0,0 +1,70 @@
+//
+//  SafeCastConcurrentEnumeration.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#undef SAFE_CAST_CONCURRENT
+#define SAFE_CAST_CONCURRENT(criterion) -(void)safe_enumerateObjects ## criterion concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(void (^)(id obj, NSUInteger idx, BOOL *stop))block {\
+if (block == nil) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Block passed to %@ must not be nil", NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}\
+SafeCastApplyChunks(self.count, grainSize, ^(NSRange range, SafeCastStopFlag *stop) {\
+SAFE_CAST_TEST_SETUP \
+__unsafe_unretained id objects[SAFE_CAST_BATCH_SIZE];\
+for (NSUInteger location = range.location; location < NSMaxRange(range); location += SAFE_CAST_BATCH_SIZE) {\
+NSRange batch = NSMakeRange(location, MIN((NSUInteger)SAFE_CAST_BATCH_SIZE, NSMaxRange(range) - location));\
+[self getObjects:objects range:batch];\
+for (NSUInteger i = 0; i < batch.length; i++) {\
+if (SafeCastShouldStop(stop)) {return;}\
+__unsafe_unretained id obj = objects[i];\
+if SAFE_CAST_TEST {\
+BOOL stopEnumerating = NO;\
+block(obj, batch.location + i, &stopEnumerating);\
+if (stopEnumerating) {SafeCastStop(stop); return;}}}}});}
+
+#pragma mark - Kind of Class
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_CONCURRENT(OfKind:(Class)class)
+
+#pragma mark - Protocols
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_CONCURRENT(ConformingToProtocol:(Protocol *)protocol)
+
+#pragma mark - Selectors
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+// The memo is not thread-safe, so each chunk keeps its own.
+#define SAFE_CAST_TEST_SETUP SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_CONCURRENT(RespondingToSelector:(SEL)selector)
+
+#undef SAFE_CAST_TEST_SETUP
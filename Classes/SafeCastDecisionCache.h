@@ -0,0 +1,162 @@
+//
+//  SafeCastDecisionCache.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <stdatomic.h>
+#import <objc/runtime.h>
+#import "NSObject+SafeCast.h"
+
+/*
+ A decision cache maps a pair of pointers -- typically the class of an object and the Class, Protocol or selector it is being tested against -- to a verdict.
+
+ Tables have a fixed, power-of-two capacity. Entries are immutable once published and are never removed while the table is alive, so readers take no locks: a lookup is a hash, an acquire load and a pointer compare. Writers race with a single compare-and-swap per slot. A key that cannot be placed within a short probe sequence is simply not cached and callers fall back to asking the runtime.
+
+ Cached verdicts assume that the answer depends only on the class of the object. Classes that override the method being answered (NSProxy subclasses, or anything else that overrides -isKindOfClass:) are recorded with SafeCastVerdictAskObject so that every instance is asked directly.
+
+ Entries are keyed by the address of the class and are never invalidated. A class created at runtime and later destroyed with objc_disposeClassPair leaves its entries behind, and a new class allocated at the same address would be answered with the old class's verdicts. Code that disposes of classes must not test instances of classes that can reuse that memory against the same targets through SafeCast. Classes loaded from images, and the subclasses KVO creates, are never disposed, so this does not arise for them.
+ */
+
+typedef NS_ENUM(uintptr_t, SafeCastVerdict) {
+    SafeCastVerdictNo = 0,
+    SafeCastVerdictYes = 1,
+    SafeCastVerdictAskObject = 2,
+};
+
+typedef struct SafeCastDecision {
+    const void *key;
+    const void *target;
+    uintptr_t verdict;
+} SafeCastDecision;
+
+typedef struct SafeCastDecisionTable {
+    _Atomic(SafeCastDecision *) *slots;
+    NSUInteger mask;
+} SafeCastDecisionTable;
+
+#define SAFE_CAST_DECISION_CACHE_PROBES 8
+
+static inline NSUInteger SafeCastDecisionHash(const void *key, const void *target)
+{
+    uintptr_t h = ((uintptr_t)key >> 3) ^ ((uintptr_t)target >> 2);
+    return (NSUInteger)(h * 2654435761u);
+}
+
+static inline BOOL SafeCastDecisionTableLookup(SafeCastDecisionTable *table, const void *key, const void *target, uintptr_t *verdict)
+{
+    NSUInteger i = SafeCastDecisionHash(key, target);
+    for (NSUInteger probe = 0; probe < SAFE_CAST_DECISION_CACHE_PROBES; probe++, i++) {
+        SafeCastDecision *decision = atomic_load_explicit(&table->slots[i & table->mask], memory_order_acquire);
+        if (decision == NULL) {
+            return NO;
+        }
+        if (decision->key == key && decision->target == target) {
+            *verdict = decision->verdict;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+FOUNDATION_EXTERN void SafeCastDecisionTableInsert(SafeCastDecisionTable *table, const void *key, const void *target, uintptr_t verdict);
+
+/**
+ Returns YES if the class answers the given selector with the implementation inherited from NSObject, i.e. the answer for an instance can be safely cached against its class.
+ */
+FOUNDATION_EXTERN BOOL SafeCastClassUsesRootImplementation(Class cls, SEL selector);
+
+/**
+ Equivalent to @code [obj conformsToProtocol:protocol] @endcode, answered from a process-wide cache after the first time a given class of object is tested against protocol.
+ */
+FOUNDATION_EXTERN BOOL SafeCastConformsToProtocol(id obj, Protocol *protocol);
+
+/**
+ Returns YES if the method the object would run for selector is declared to return an object. Methods the runtime cannot describe are answered from -methodSignatureForSelector:.
+ */
+FOUNDATION_EXTERN BOOL SafeCastMethodReturnsObject(id obj, SEL selector);
+
+/**
+ Returns YES if selector is in the alloc, new, copy, mutableCopy or init method family, whose methods return an object the caller owns. Methods in the init family also consume their receiver.
+ */
+FOUNDATION_EXTERN BOOL SafeCastSelectorReturnsRetained(SEL selector);
+
+/*
+ A small direct-mapped memo of the implementation of one selector for each class seen during a single pass over a collection. It lives on the stack of the enumerating method and is not thread-safe.
+
+ A NULL implementation records that instances of the class do not respond to the selector, or, when requiresObjectReturn is set, that their method does not return an object. Classes that override -respondsToSelector: are never memoized; each of their instances is asked directly.
+ */
+
+#define SAFE_CAST_IMP_MEMO_SIZE 8
+
+typedef struct SafeCastIMPMemo {
+    SEL selector;
+    __unsafe_unretained Class classes[SAFE_CAST_IMP_MEMO_SIZE];
+    IMP imps[SAFE_CAST_IMP_MEMO_SIZE];
+    BOOL requiresObjectReturn;
+} SafeCastIMPMemo;
+
+static inline IMP SafeCastIMPForObject(id obj, SEL selector)
+{
+    return [obj respondsToSelector:selector] ? class_getMethodImplementation(object_getClass(obj), selector) : NULL;
+}
+
+static inline IMP SafeCastIMPMemoLookup(SafeCastIMPMemo *memo, id obj)
+{
+    Class cls = object_getClass(obj);
+    NSUInteger slot = ((uintptr_t)cls >> 4) & (SAFE_CAST_IMP_MEMO_SIZE - 1);
+    if (memo->classes[slot] == cls) {
+        return memo->imps[slot];
+    }
+
+    IMP imp = SafeCastIMPForObject(obj, memo->selector);
+    if (imp != NULL && memo->requiresObjectReturn && !SafeCastMethodReturnsObject(obj, memo->selector)) {
+        imp = NULL;
+    }
+    if (SafeCastClassUsesRootImplementation(cls, @selector(respondsToSelector:))) {
+        memo->classes[slot] = cls;
+        memo->imps[slot] = imp;
+    }
+    return imp;
+}
+
+@class SafeCastClassSet;
+
+/**
+ Equivalent to @code [set indexOfKindOfObject:obj] @endcode without the message send.
+ */
+FOUNDATION_EXTERN NSUInteger SafeCastClassSetIndexOfObject(SafeCastClassSet *set, id obj);
+
+/**
+ Returns classes itself if it is already a SafeCastClassSet, or a new class set built from it.
+ */
+FOUNDATION_EXTERN SafeCastClassSet *SafeCastClassSetWithClasses(id<NSFastEnumeration> classes);
+
+@class SafeCastFilter;
+
+/**
+ Equivalent to @code [filter matchesObject:obj] @endcode without the message send.
+ */
+FOUNDATION_EXTERN BOOL SafeCastFilterMatchesObject(SafeCastFilter *filter, id obj);
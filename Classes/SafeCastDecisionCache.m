@@ -0,0 +1,167 @@
+//
+//  SafeCastDecisionCache.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastDecisionCache.h"
+#import <objc/runtime.h>
+#import <ctype.h>
+#import <string.h>
+
+#define SAFE_CAST_DECISION_CACHE_CAPACITY 4096
+
+static _Atomic(SafeCastDecision *) SafeCastKindSlots[SAFE_CAST_DECISION_CACHE_CAPACITY];
+static SafeCastDecisionTable SafeCastKindTable = { SafeCastKindSlots, SAFE_CAST_DECISION_CACHE_CAPACITY - 1 };
+
+static _Atomic(SafeCastDecision *) SafeCastProtocolSlots[SAFE_CAST_DECISION_CACHE_CAPACITY];
+static SafeCastDecisionTable SafeCastProtocolTable = { SafeCastProtocolSlots, SAFE_CAST_DECISION_CACHE_CAPACITY - 1 };
+
+void SafeCastDecisionTableInsert(SafeCastDecisionTable *table, const void *key, const void *target, uintptr_t verdict)
+{
+    // Probe before allocating, so that inserting into a full window costs loads only.
+    SafeCastDecision *decision = NULL;
+    NSUInteger i = SafeCastDecisionHash(key, target);
+    for (NSUInteger probe = 0; probe < SAFE_CAST_DECISION_CACHE_PROBES; probe++, i++) {
+        _Atomic(SafeCastDecision *) *slot = &table->slots[i & table->mask];
+        SafeCastDecision *expected = atomic_load_explicit(slot, memory_order_acquire);
+        if (expected == NULL) {
+            if (decision == NULL) {
+                decision = malloc(sizeof(SafeCastDecision));
+                if (decision == NULL) {
+                    return;
+                }
+                decision->key = key;
+                decision->target = target;
+                decision->verdict = verdict;
+            }
+            if (atomic_compare_exchange_strong_explicit(slot, &expected, decision, memory_order_release, memory_order_acquire)) {
+                return;
+            }
+        }
+        if (expected->key == key && expected->target == target) {
+            // Another thread published the same decision first.
+            break;
+        }
+    }
+    free(decision);
+}
+
+BOOL SafeCastClassUsesRootImplementation(Class cls, SEL selector)
+{
+    Class root = [NSObject class];
+    if (class_isMetaClass(cls)) {
+        root = object_getClass(root);
+    }
+    return class_getMethodImplementation(cls, selector) == class_getMethodImplementation(root, selector);
+}
+
+// Skips the type qualifiers (const, in, inout, out, bycopy, byref, oneway) that may precede a type encoding.
+static BOOL SafeCastTypeEncodingIsObject(const char *types)
+{
+    if (types == NULL) {
+        return NO;
+    }
+    while (*types != '\0' && strchr("rnNoORV", *types) != NULL) {
+        types++;
+    }
+    return *types == '@';
+}
+
+BOOL SafeCastMethodReturnsObject(id obj, SEL selector)
+{
+    Method method = class_getInstanceMethod(object_getClass(obj), selector);
+    if (method != NULL) {
+        return SafeCastTypeEncodingIsObject(method_getTypeEncoding(method));
+    }
+    NSMethodSignature *signature = [obj methodSignatureForSelector:selector];
+    return signature != nil && SafeCastTypeEncodingIsObject(signature.methodReturnType);
+}
+
+static BOOL SafeCastSelectorNameIsInFamily(const char *name, const char *family)
+{
+    size_t length = strlen(family);
+    return strncmp(name, family, length) == 0 && !islower((unsigned char)name[length]);
+}
+
+BOOL SafeCastSelectorReturnsRetained(SEL selector)
+{
+    const char *name = sel_getName(selector);
+    while (*name == '_') {
+        name++;
+    }
+    return SafeCastSelectorNameIsInFamily(name, "alloc") || SafeCastSelectorNameIsInFamily(name, "new") ||
+        SafeCastSelectorNameIsInFamily(name, "copy") || SafeCastSelectorNameIsInFamily(name, "mutableCopy") ||
+        SafeCastSelectorNameIsInFamily(name, "init");
+}
+
+BOOL SafeCastIsKindOfClass(id obj, Class cls)
+{
+    if (obj == nil) {
+        return NO;
+    }
+
+    const void *key = (__bridge const void *)object_getClass(obj);
+    const void *target = (__bridge const void *)cls;
+    uintptr_t verdict;
+
+    if (!SafeCastDecisionTableLookup(&SafeCastKindTable, key, target, &verdict)) {
+        if (SafeCastClassUsesRootImplementation(object_getClass(obj), @selector(isKindOfClass:))) {
+            verdict = [obj isKindOfClass:cls] ? SafeCastVerdictYes : SafeCastVerdictNo;
+        } else {
+            verdict = SafeCastVerdictAskObject;
+        }
+        SafeCastDecisionTableInsert(&SafeCastKindTable, key, target, verdict);
+    }
+
+    if (verdict == SafeCastVerdictAskObject) {
+        return [obj isKindOfClass:cls];
+    }
+    return verdict == SafeCastVerdictYes;
+}
+
+BOOL SafeCastConformsToProtocol(id obj, Protocol *protocol)
+{
+    if (obj == nil) {
+        return NO;
+    }
+
+    const void *key = (__bridge const void *)object_getClass(obj);
+    const void *target = (__bridge const void *)protocol;
+    uintptr_t verdict;
+
+    if (!SafeCastDecisionTableLookup(&SafeCastProtocolTable, key, target, &verdict)) {
+        if (SafeCastClassUsesRootImplementation(object_getClass(obj), @selector(conformsToProtocol:))) {
+            verdict = [obj conformsToProtocol:protocol] ? SafeCastVerdictYes : SafeCastVerdictNo;
+        } else {
+            verdict = SafeCastVerdictAskObject;
+        }
+        SafeCastDecisionTableInsert(&SafeCastProtocolTable, key, target, verdict);
+    }
+
+    if (verdict == SafeCastVerdictAskObject) {
+        return [obj conformsToProtocol:protocol];
+    }
+    return verdict == SafeCastVerdictYes;
+}
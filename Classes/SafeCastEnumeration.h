@@ -25,34 +25,138 @@
 //  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+// Enumeration calls the caller's block directly for each matching element, with unretained references.
+// Ordered collections and sets are walked in fast-enumeration batches, and ordered collections are walked backwards in
+// batches copied out with -getObjects:range:. Dictionaries walk their keys in fast-enumeration batches and look each
+// object up into a strong local, so values a dictionary creates on demand stay alive while the block runs. Nothing is
+// copied and an early stop costs nothing; only concurrent enumeration copies their keys and objects out once.
+// Concurrent enumeration splits the elements into chunks with SafeCastApplyChunks().
+
 #define SAFE_CAST_PREFIX(objects, kind, opts) -(void)safe_enumerate ## objects ## kind opts usingBlock:(void(^)
 
-#define SAFE_CAST_ENUMERATE(objects) block{[self enumerate ## objects ## UsingBlock: ^SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE {\
-if SAFE_CAST_TEST {block(SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS);}}];}
+#undef SAFE_CAST_BLOCK_PRECONDITION
+#define SAFE_CAST_BLOCK_PRECONDITION if (block == nil) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Block passed to %@ must not be nil", NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}
+
+#undef SAFE_CAST_ENUMERATE_SERIAL
+#undef SAFE_CAST_ENUMERATE_REVERSE
+#undef SAFE_CAST_ENUMERATE_CONCURRENT
+#undef SAFE_CAST_KEYED_BUFFERS_BEGIN
+#undef SAFE_CAST_KEYED_BUFFERS_END
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_KEYED_BUFFERS_BEGIN NSUInteger count = self.count;\
+SafeCastObjectBuffer keys, objects;\
+SafeCastObjectBufferInitWithCapacity(&keys, count);\
+SafeCastObjectBufferInitWithCapacity(&objects, count);\
+[self getObjects:objects.objects andKeys:keys.objects count:count];
+
+#define SAFE_CAST_KEYED_BUFFERS_END SafeCastObjectBufferFree(&keys);\
+SafeCastObjectBufferFree(&objects);
+
+#define SAFE_CAST_ENUMERATE_SERIAL BOOL stop = NO;\
+SAFE_CAST_BATCH_BEGIN(self, key)\
+id obj = [self objectForKey:key];\
+if SAFE_CAST_TEST {\
+block(key, obj, &stop);\
+if (stop) SAFE_CAST_BATCH_BREAK}\
+SAFE_CAST_BATCH_END
+
+// Dictionaries are unordered, so NSEnumerationReverse has no effect.
+#define SAFE_CAST_ENUMERATE_REVERSE SAFE_CAST_ENUMERATE_SERIAL
+
+#define SAFE_CAST_ENUMERATE_CONCURRENT SAFE_CAST_KEYED_BUFFERS_BEGIN \
+__unsafe_unretained id *keyList = keys.objects;\
+__unsafe_unretained id *objectList = objects.objects;\
+SafeCastApplyChunks(count, 0, ^(NSRange range, SafeCastStopFlag *stop) {\
+for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {\
+if (SafeCastShouldStop(stop)) {return;}\
+__unsafe_unretained id obj = objectList[i];\
+if SAFE_CAST_TEST {\
+BOOL stopEnumerating = NO;\
+block(keyList[i], obj, &stopEnumerating);\
+if (stopEnumerating) {SafeCastStop(stop); return;}}}});\
+SAFE_CAST_KEYED_BUFFERS_END
+#else
+#define SAFE_CAST_ENUMERATE_SERIAL BOOL stop = NO;\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if SAFE_CAST_TEST {\
+block(SAFE_CAST_ENUMERATE_BATCH_ARGUMENTS);\
+if (stop) SAFE_CAST_BATCH_BREAK}\
+SAFE_CAST_BATCH_END
+
+#ifdef SAFE_CAST_ORDERED_ENUMERATION
+#define SAFE_CAST_ENUMERATE_REVERSE BOOL stop = NO;\
+SAFE_CAST_RANGE_BEGIN(self, NSMakeRange(0, self.count), YES, obj)\
+if SAFE_CAST_TEST {\
+block(obj, SAFE_CAST_RANGE_INDEX, &stop);\
+if (stop) SAFE_CAST_RANGE_BREAK}\
+SAFE_CAST_RANGE_END
+
+#define SAFE_CAST_ENUMERATE_CONCURRENT SafeCastApplyChunks(self.count, 0, ^(NSRange range, SafeCastStopFlag *stop) {\
+__unsafe_unretained id objects[SAFE_CAST_BATCH_SIZE];\
+for (NSUInteger location = range.location; location < NSMaxRange(range); location += SAFE_CAST_BATCH_SIZE) {\
+NSRange batch = NSMakeRange(location, MIN((NSUInteger)SAFE_CAST_BATCH_SIZE, NSMaxRange(range) - location));\
+[self getObjects:objects range:batch];\
+for (NSUInteger i = 0; i < batch.length; i++) {\
+if (SafeCastShouldStop(stop)) {return;}\
+__unsafe_unretained id obj = objects[i];\
+if SAFE_CAST_TEST {\
+BOOL stopEnumerating = NO;\
+block(obj, batch.location + i, &stopEnumerating);\
+if (stopEnumerating) {SafeCastStop(stop); return;}}}}});
+#else
+// Sets are unordered, so NSEnumerationReverse has no effect.
+#define SAFE_CAST_ENUMERATE_REVERSE SAFE_CAST_ENUMERATE_SERIAL
+
+// Sets have no indexed access, so concurrent enumeration copies the objects out once.
+#define SAFE_CAST_ENUMERATE_CONCURRENT SafeCastObjectBuffer objects;\
+SafeCastObjectBufferInitWithCapacity(&objects, self.count);\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+SafeCastObjectBufferAppend(&objects, obj);\
+SAFE_CAST_BATCH_END\
+__unsafe_unretained id *objectList = objects.objects;\
+SafeCastApplyChunks(objects.count, 0, ^(NSRange range, SafeCastStopFlag *stop) {\
+for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {\
+if (SafeCastShouldStop(stop)) {return;}\
+__unsafe_unretained id obj = objectList[i];\
+if SAFE_CAST_TEST {\
+BOOL stopEnumerating = NO;\
+block(obj, &stopEnumerating);\
+if (stopEnumerating) {SafeCastStop(stop); return;}}}});\
+SafeCastObjectBufferFree(&objects);
+#endif
+#endif
+
+#define SAFE_CAST_ENUMERATE block{SAFE_CAST_BLOCK_PRECONDITION SAFE_CAST_TEST_SETUP SAFE_CAST_ENUMERATE_SERIAL}
 
-#define SAFE_CAST_ENUMERATE_WITH_OPTIONS(objects) block{[self enumerate ## objects ## WithOptions: opts usingBlock:^SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE {\
-if SAFE_CAST_TEST {block(SAFE_CAST_ENUMERATE_BLOCK_PARAMETERS);}}];}
+#define SAFE_CAST_ENUMERATE_WITH_OPTIONS block{SAFE_CAST_BLOCK_PRECONDITION SAFE_CAST_TEST_SETUP \
+if (opts & NSEnumerationConcurrent) {SAFE_CAST_ENUMERATE_CONCURRENT}\
+else if (opts & NSEnumerationReverse) {SAFE_CAST_ENUMERATE_REVERSE}\
+else {SAFE_CAST_ENUMERATE_SERIAL}}
 
 #undef SAFE_CAST_TEST
-#define SAFE_CAST_TEST ([obj isKindOfClass:class])
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
 
 #ifdef SAFE_CAST_KEYED_ENUMERATION
-SAFE_CAST_PREFIX(KeysAndObjects,OfKind:(Class)class,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(KeysAndObjects)
-SAFE_CAST_PREFIX(KeysAndObjects,OfKind:(Class)class,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE) SAFE_CAST_ENUMERATE_WITH_OPTIONS(KeysAndObjects)
+SAFE_CAST_PREFIX(KeysAndObjects,OfKind:(Class)class,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(KeysAndObjects,OfKind:(Class)class,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE) SAFE_CAST_ENUMERATE_WITH_OPTIONS
 #else
-SAFE_CAST_PREFIX(Objects,OfKind:(Class)class,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(Objects)
-SAFE_CAST_PREFIX(Objects,OfKind:(Class)class,withOptions:(NSEnumerationOptions)opts)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS(Objects)
+SAFE_CAST_PREFIX(Objects,OfKind:(Class)class,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(Objects,OfKind:(Class)class,withOptions:(NSEnumerationOptions)opts)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS
 #endif
 
 #undef SAFE_CAST_TEST
-#define SAFE_CAST_TEST ([obj conformsToProtocol:protocol])
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
 
 #ifdef SAFE_CAST_KEYED_ENUMERATION
-SAFE_CAST_PREFIX(KeysAndObjects,ConformingToProtocol:(Protocol*)protocol,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(KeysAndObjects)
-SAFE_CAST_PREFIX(KeysAndObjects,ConformingToProtocol:(Protocol*)protocol,withOptions:(NSEnumerationOptions)opts)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS(KeysAndObjects)
+SAFE_CAST_PREFIX(KeysAndObjects,ConformingToProtocol:(Protocol*)protocol,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(KeysAndObjects,ConformingToProtocol:(Protocol*)protocol,withOptions:(NSEnumerationOptions)opts)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE) SAFE_CAST_ENUMERATE_WITH_OPTIONS
 #else
-SAFE_CAST_PREFIX(Objects,ConformingToProtocol:(Protocol*)protocol,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(Objects)
-SAFE_CAST_PREFIX(Objects,ConformingToProtocol:(Protocol*)protocol,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS(Objects)
+SAFE_CAST_PREFIX(Objects,ConformingToProtocol:(Protocol*)protocol,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(Objects,ConformingToProtocol:(Protocol*)protocol,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS
 #endif
 
 #undef SAFE_CAST_TEST
@@ -60,9 +164,39 @@ SAFE_CAST_PREFIX(Objects,ConformingToProtocol:(Protocol*)protocol,withOptions:(N
 
 #ifdef SAFE_CAST_KEYED_ENUMERATION
 // Responding to selector
-SAFE_CAST_PREFIX(KeysAndObjects, RespondingToSelector:(SEL)selector,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(KeysAndObjects)
-SAFE_CAST_PREFIX(KeysAndObjects, RespondingToSelector:(SEL)selector,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(KeysAndObjects)
+SAFE_CAST_PREFIX(KeysAndObjects, RespondingToSelector:(SEL)selector,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(KeysAndObjects, RespondingToSelector:(SEL)selector,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE) SAFE_CAST_ENUMERATE_WITH_OPTIONS
+#else
+SAFE_CAST_PREFIX(Objects, RespondingToSelector:(SEL)selector,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(Objects,RespondingToSelector:(SEL)selector,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS
+#endif
+
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SafeCastClassSet *classSet = SafeCastClassSetWithClasses(classes);
+#define SAFE_CAST_TEST (SafeCastClassSetIndexOfObject(classSet, obj) != NSNotFound)
+
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+// Kinds of classes
+SAFE_CAST_PREFIX(KeysAndObjects, OfKinds:(id<NSFastEnumeration>)classes,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(KeysAndObjects, OfKinds:(id<NSFastEnumeration>)classes,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE) SAFE_CAST_ENUMERATE_WITH_OPTIONS
 #else
-SAFE_CAST_PREFIX(Objects, RespondingToSelector:(SEL)selector,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE(Objects)
-SAFE_CAST_PREFIX(Objects,RespondingToSelector:(SEL)selector,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS(Objects)
+SAFE_CAST_PREFIX(Objects, OfKinds:(id<NSFastEnumeration>)classes,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(Objects,OfKinds:(id<NSFastEnumeration>)classes,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS
 #endif
+
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastFilterMatchesObject(filter, obj))
+
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+// Matching a filter
+SAFE_CAST_PREFIX(KeysAndObjects, MatchingFilter:(SafeCastFilter *)filter,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(KeysAndObjects, MatchingFilter:(SafeCastFilter *)filter,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE) SAFE_CAST_ENUMERATE_WITH_OPTIONS
+#else
+SAFE_CAST_PREFIX(Objects, MatchingFilter:(SafeCastFilter *)filter,) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE
+SAFE_CAST_PREFIX(Objects,MatchingFilter:(SafeCastFilter *)filter,withOptions:(NSEnumerationOptions)opts) SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)SAFE_CAST_ENUMERATE_WITH_OPTIONS
+#endif
+
+#undef SAFE_CAST_TEST_SETUP
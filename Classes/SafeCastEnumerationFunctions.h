@@ -0,0 +1,45 @@
+//
+//  SafeCastEnumerationFunctions.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ C functions that can be passed to the safe_enumerate...:function:context: methods in place of a block.
+
+ The function is called directly for each matching element, with no block invocation, and the element is passed without being retained. The context pointer is passed through untouched; use it to carry whatever state the function needs.
+
+ Setting *stop to YES stops the enumeration after the function returns.
+ */
+
+/** Called for each matching element of an NSArray or NSOrderedSet, with its index. */
+typedef void (*SafeCastIndexedEnumerationFunction)(__unsafe_unretained __nonnull id obj, NSUInteger idx, BOOL * __nonnull stop, void * __nullable context);
+
+/** Called for each matching element of an NSSet. */
+typedef void (*SafeCastEnumerationFunction)(__unsafe_unretained __nonnull id obj, BOOL * __nonnull stop, void * __nullable context);
+
+/** Called for each entry of an NSDictionary whose object matches. */
+typedef void (*SafeCastKeyedEnumerationFunction)(__unsafe_unretained __nonnull id key, __unsafe_unretained __nonnull id obj, BOOL * __nonnull stop, void * __nullable context);
@@ -0,0 +1,49 @@
+//
+//  SafeCastFastEnumeration.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+@class SafeCastFilter;
+
+/**
+ A filtered view of another NSFastEnumeration source, for use in for-in loops.
+
+ Each call to -countByEnumeratingWithState:objects:count: pulls batches from the source and compacts only the objects that pass the test into the caller's buffer. No blocks are invoked and nothing is copied.
+
+ An instance keeps the position of its source enumeration internally, so it supports one enumeration at a time. Nested loops over the same source should each use their own instance. As with any for-in loop, mutating the source while enumerating raises an exception.
+ */
+@interface SafeCastFastEnumeration : NSObject <NSFastEnumeration>
+
+- (nonnull instancetype)initWithSource:(nonnull id<NSFastEnumeration>)source kind:(nonnull Class)class;
+
+- (nonnull instancetype)initWithSource:(nonnull id<NSFastEnumeration>)source protocol:(nonnull Protocol *)protocol;
+
+- (nonnull instancetype)initWithSource:(nonnull id<NSFastEnumeration>)source selector:(nonnull SEL)selector;
+
+- (nonnull instancetype)initWithSource:(nonnull id<NSFastEnumeration>)source filter:(nonnull SafeCastFilter *)filter;
+
+@end
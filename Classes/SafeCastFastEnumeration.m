@@ -0,0 +1,151 @@
+//
+//  SafeCastFastEnumeration.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastFastEnumeration.h"
+#import "SafeCastDecisionCache.h"
+#import "SafeCastBatch.h"
+
+typedef NS_ENUM(NSUInteger, SafeCastCriterion) {
+    SafeCastCriterionKind,
+    SafeCastCriterionProtocol,
+    SafeCastCriterionSelector,
+    SafeCastCriterionFilter,
+};
+
+@implementation SafeCastFastEnumeration {
+    id<NSFastEnumeration> _source;
+    SafeCastCriterion _criterion;
+    Class _class;
+    Protocol *_protocol;
+    SafeCastIMPMemo _memo;
+    SafeCastFilter *_filter;
+
+    NSFastEnumerationState _sourceState;
+    __unsafe_unretained id _sourceBuffer[SAFE_CAST_BATCH_SIZE];
+    NSUInteger _sourceCount;
+    NSUInteger _sourcePosition;
+    BOOL _sourceExhausted;
+}
+
+- (instancetype)initWithSource:(id<NSFastEnumeration>)source criterion:(SafeCastCriterion)criterion
+{
+    self = [super init];
+    if (self) {
+        _source = source;
+        _criterion = criterion;
+    }
+    return self;
+}
+
+- (instancetype)initWithSource:(id<NSFastEnumeration>)source kind:(Class)class
+{
+    self = [self initWithSource:source criterion:SafeCastCriterionKind];
+    if (self) {
+        _class = class;
+    }
+    return self;
+}
+
+- (instancetype)initWithSource:(id<NSFastEnumeration>)source protocol:(Protocol *)protocol
+{
+    self = [self initWithSource:source criterion:SafeCastCriterionProtocol];
+    if (self) {
+        _protocol = protocol;
+    }
+    return self;
+}
+
+- (instancetype)initWithSource:(id<NSFastEnumeration>)source selector:(SEL)selector
+{
+    self = [self initWithSource:source criterion:SafeCastCriterionSelector];
+    if (self) {
+        _memo.selector = selector;
+    }
+    return self;
+}
+
+- (instancetype)initWithSource:(id<NSFastEnumeration>)source filter:(SafeCastFilter *)filter
+{
+    self = [self initWithSource:source criterion:SafeCastCriterionFilter];
+    if (self) {
+        _filter = filter;
+    }
+    return self;
+}
+
+static inline BOOL SafeCastFastEnumerationMatches(SafeCastFastEnumeration *self, __unsafe_unretained id obj)
+{
+    switch (self->_criterion) {
+        case SafeCastCriterionKind:
+            return SafeCastIsKindOfClass(obj, self->_class);
+        case SafeCastCriterionProtocol:
+            return SafeCastConformsToProtocol(obj, self->_protocol);
+        case SafeCastCriterionSelector:
+            return SafeCastIMPMemoLookup(&self->_memo, obj) != NULL;
+        case SafeCastCriterionFilter:
+            return SafeCastFilterMatchesObject(self->_filter, obj);
+    }
+    return NO;
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+    if (state->state == 0) {
+        memset(&_sourceState, 0, sizeof(_sourceState));
+        _sourceCount = 0;
+        _sourcePosition = 0;
+        _sourceExhausted = NO;
+        state->state = 1;
+        state->mutationsPtr = &state->extra[0];
+    }
+
+    NSUInteger count = 0;
+    while (count < len) {
+        if (_sourcePosition == _sourceCount) {
+            if (_sourceExhausted) {
+                break;
+            }
+            _sourceCount = [_source countByEnumeratingWithState:&_sourceState objects:_sourceBuffer count:SAFE_CAST_BATCH_SIZE];
+            _sourcePosition = 0;
+            if (_sourceCount == 0) {
+                _sourceExhausted = YES;
+                break;
+            }
+            // Forward the source's mutation counter so for-in detects mutation of the source.
+            state->mutationsPtr = _sourceState.mutationsPtr;
+        }
+        __unsafe_unretained id obj = _sourceState.itemsPtr[_sourcePosition++];
+        if (SafeCastFastEnumerationMatches(self, obj)) {
+            buffer[count++] = obj;
+        }
+    }
+
+    state->itemsPtr = buffer;
+    return count;
+}
+
+@end
@@ -0,0 +1,53 @@
+//
+//  SafeCastFastEnumerationAdaptors.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#undef SAFE_CAST_FAST_ENUMERATION_SOURCE
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_FAST_ENUMERATION_SOURCE [self objectEnumerator]
+#else
+#define SAFE_CAST_FAST_ENUMERATION_SOURCE self
+#endif
+
+- (id<NSFastEnumeration>)safe_fastEnumerationOfKind:(Class)class
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:SAFE_CAST_FAST_ENUMERATION_SOURCE kind:class];
+}
+
+- (id<NSFastEnumeration>)safe_fastEnumerationConformingToProtocol:(Protocol *)protocol
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:SAFE_CAST_FAST_ENUMERATION_SOURCE protocol:protocol];
+}
+
+- (id<NSFastEnumeration>)safe_fastEnumerationRespondingToSelector:(SEL)selector
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:SAFE_CAST_FAST_ENUMERATION_SOURCE selector:selector];
+}
+
+- (SafeCastSequence *)safe_sequence
+{
+    return [SafeCastSequence sequenceWithSource:SAFE_CAST_FAST_ENUMERATION_SOURCE];
+}
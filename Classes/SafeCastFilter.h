@@ -0,0 +1,95 @@
+//
+//  SafeCastFilter.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ A reusable predicate over objects built from kind, protocol and selector clauses, combined with AND, OR and NOT.
+
+ A filter's verdict for a given class of object is computed once, by evaluating every clause, and remembered for the life of the filter. After that, testing any object of that class is a single hash lookup no matter how many clauses the filter has. If any clause would be answered by a class that overrides -isKindOfClass:, -conformsToProtocol: or -respondsToSelector:, objects of that class are evaluated clause by clause every time.
+
+ Filters are immutable and safe to use from multiple threads at once. Build one up front and reuse it.
+
+ @code
+ SafeCastFilter *prefetchable = [SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:[MyModel class]],
+                                                                     [SafeCastFilter filterConformingToProtocol:@protocol(Cacheable)],
+                                                                     [SafeCastFilter filterRespondingToSelector:@selector(prefetch)]]];
+ [models safe_enumerateObjectsMatchingFilter:prefetchable usingBlock:^(MyModel *model, NSUInteger idx, BOOL *stop) {
+     [model prefetch];
+ }];
+ @endcode
+ */
+@interface SafeCastFilter : NSObject <NSCopying>
+
+/**
+ @name Clauses
+ */
+
+/**
+ Returns a filter matching objects that are instances of the given class or of a subclass of it.
+ */
++ (nonnull instancetype)filterOfKind:(nonnull Class)class;
+
+/**
+ Returns a filter matching objects that conform to the given protocol.
+ */
++ (nonnull instancetype)filterConformingToProtocol:(nonnull Protocol *)protocol;
+
+/**
+ Returns a filter matching objects that respond to the given selector.
+ */
++ (nonnull instancetype)filterRespondingToSelector:(nonnull SEL)selector;
+
+/**
+ @name Combining Filters
+ */
+
+/**
+ Returns a filter matching objects that match every one of the given filters. With no filters, it matches every object.
+ */
++ (nonnull instancetype)filterMatchingAllOf:(nonnull NSArray *)filters;
+
+/**
+ Returns a filter matching objects that match at least one of the given filters. With no filters, it matches no object.
+ */
++ (nonnull instancetype)filterMatchingAnyOf:(nonnull NSArray *)filters;
+
+/**
+ Returns a filter matching exactly the objects the given filter does not.
+ */
++ (nonnull instancetype)filterNegatingFilter:(nonnull SafeCastFilter *)filter;
+
+/**
+ @name Testing Objects
+ */
+
+/**
+ Returns YES if the object matches the filter. nil never matches.
+ */
+- (BOOL)matchesObject:(nullable id)obj;
+
+@end
@@ -0,0 +1,225 @@
+//
+//  SafeCastFilter.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastFilter.h"
+#import "SafeCastDecisionCache.h"
+
+#define SAFE_CAST_FILTER_CAPACITY 256
+
+typedef NS_ENUM(NSUInteger, SafeCastFilterOperation) {
+    SafeCastFilterOperationKind,
+    SafeCastFilterOperationProtocol,
+    SafeCastFilterOperationSelector,
+    SafeCastFilterOperationAll,
+    SafeCastFilterOperationAny,
+    SafeCastFilterOperationNot,
+};
+
+// The introspection methods a filter's clauses depend on. A class that overrides any of them cannot have its verdict cached.
+typedef NS_OPTIONS(NSUInteger, SafeCastFilterDependency) {
+    SafeCastFilterDependsOnKind = 1 << 0,
+    SafeCastFilterDependsOnProtocol = 1 << 1,
+    SafeCastFilterDependsOnSelector = 1 << 2,
+};
+
+static void SafeCastRaiseAllocationFailure(id object)
+{
+    [NSException raise:NSMallocException format:@"%@ could not allocate its lookup tables", NSStringFromClass([object class])];
+}
+
+@implementation SafeCastFilter {
+    SafeCastFilterOperation _operation;
+    SafeCastFilterDependency _dependencies;
+    __unsafe_unretained Class _class;
+    Protocol *_protocol;
+    SEL _selector;
+    __unsafe_unretained SafeCastFilter **_operandList;
+    NSUInteger _operandCount;
+    NSArray *_operands;
+    _Atomic(SafeCastDecision *) *_slots;
+    SafeCastDecisionTable _table;
+}
+
+- (instancetype)initWithOperation:(SafeCastFilterOperation)operation operands:(NSArray *)operands
+{
+    // Operands are checked before anything is allocated, so a bad operand cannot leave the operand list behind.
+    for (id operand in operands) {
+        if (![operand isKindOfClass:[SafeCastFilter class]]) {
+            [[[NSException alloc] initWithName:NSInvalidArgumentException
+                                         reason:[NSString stringWithFormat:@"%@ is not a SafeCastFilter", operand]
+                                       userInfo:nil] raise];
+        }
+    }
+
+    self = [super init];
+    if (self == nil) {
+        return nil;
+    }
+    _operation = operation;
+    _operands = [operands copy];
+    _operandCount = _operands.count;
+    _operandList = (__unsafe_unretained SafeCastFilter **)calloc(MAX(_operandCount, (NSUInteger)1), sizeof(SafeCastFilter *));
+    if (_operandList == NULL) {
+        SafeCastRaiseAllocationFailure(self);
+    }
+    for (NSUInteger i = 0; i < _operandCount; i++) {
+        SafeCastFilter *operand = _operands[i];
+        _operandList[i] = operand;
+        _dependencies |= operand->_dependencies;
+    }
+    _slots = calloc(SAFE_CAST_FILTER_CAPACITY, sizeof(*_slots));
+    if (_slots == NULL) {
+        SafeCastRaiseAllocationFailure(self);
+    }
+    _table.slots = _slots;
+    _table.mask = SAFE_CAST_FILTER_CAPACITY - 1;
+    return self;
+}
+
++ (instancetype)filterOfKind:(Class)class
+{
+    SafeCastFilter *filter = [[self alloc] initWithOperation:SafeCastFilterOperationKind operands:@[]];
+    filter->_class = class;
+    filter->_dependencies = SafeCastFilterDependsOnKind;
+    return filter;
+}
+
++ (instancetype)filterConformingToProtocol:(Protocol *)protocol
+{
+    SafeCastFilter *filter = [[self alloc] initWithOperation:SafeCastFilterOperationProtocol operands:@[]];
+    filter->_protocol = protocol;
+    filter->_dependencies = SafeCastFilterDependsOnProtocol;
+    return filter;
+}
+
++ (instancetype)filterRespondingToSelector:(SEL)selector
+{
+    SafeCastFilter *filter = [[self alloc] initWithOperation:SafeCastFilterOperationSelector operands:@[]];
+    filter->_selector = selector;
+    filter->_dependencies = SafeCastFilterDependsOnSelector;
+    return filter;
+}
+
++ (instancetype)filterMatchingAllOf:(NSArray *)filters
+{
+    return [[self alloc] initWithOperation:SafeCastFilterOperationAll operands:filters];
+}
+
++ (instancetype)filterMatchingAnyOf:(NSArray *)filters
+{
+    return [[self alloc] initWithOperation:SafeCastFilterOperationAny operands:filters];
+}
+
++ (instancetype)filterNegatingFilter:(SafeCastFilter *)filter
+{
+    return [[self alloc] initWithOperation:SafeCastFilterOperationNot operands:@[filter]];
+}
+
+- (void)dealloc
+{
+    if (_slots != NULL) {
+        for (NSUInteger i = 0; i < SAFE_CAST_FILTER_CAPACITY; i++) {
+            free(atomic_load_explicit(&_slots[i], memory_order_relaxed));
+        }
+    }
+    free(_slots);
+    free(_operandList);
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+- (BOOL)matchesObject:(id)obj
+{
+    return SafeCastFilterMatchesObject(self, obj);
+}
+
+static BOOL SafeCastFilterEvaluate(SafeCastFilter *filter, id obj)
+{
+    switch (filter->_operation) {
+        case SafeCastFilterOperationKind:
+            return [obj isKindOfClass:filter->_class];
+        case SafeCastFilterOperationProtocol:
+            return [obj conformsToProtocol:filter->_protocol];
+        case SafeCastFilterOperationSelector:
+            return [obj respondsToSelector:filter->_selector];
+        case SafeCastFilterOperationAll:
+            for (NSUInteger i = 0; i < filter->_operandCount; i++) {
+                if (!SafeCastFilterEvaluate(filter->_operandList[i], obj)) {
+                    return NO;
+                }
+            }
+            return YES;
+        case SafeCastFilterOperationAny:
+            for (NSUInteger i = 0; i < filter->_operandCount; i++) {
+                if (SafeCastFilterEvaluate(filter->_operandList[i], obj)) {
+                    return YES;
+                }
+            }
+            return NO;
+        case SafeCastFilterOperationNot:
+            return !SafeCastFilterEvaluate(filter->_operandList[0], obj);
+    }
+    return NO;
+}
+
+static BOOL SafeCastFilterIsCacheable(SafeCastFilter *filter, Class cls)
+{
+    SafeCastFilterDependency dependencies = filter->_dependencies;
+    return (!(dependencies & SafeCastFilterDependsOnKind) || SafeCastClassUsesRootImplementation(cls, @selector(isKindOfClass:))) &&
+           (!(dependencies & SafeCastFilterDependsOnProtocol) || SafeCastClassUsesRootImplementation(cls, @selector(conformsToProtocol:))) &&
+           (!(dependencies & SafeCastFilterDependsOnSelector) || SafeCastClassUsesRootImplementation(cls, @selector(respondsToSelector:)));
+}
+
+BOOL SafeCastFilterMatchesObject(SafeCastFilter *filter, id obj)
+{
+    if (obj == nil) {
+        return NO;
+    }
+
+    Class cls = object_getClass(obj);
+    const void *key = (__bridge const void *)cls;
+    uintptr_t verdict;
+
+    if (!SafeCastDecisionTableLookup(&filter->_table, key, NULL, &verdict)) {
+        if (SafeCastFilterIsCacheable(filter, cls)) {
+            verdict = SafeCastFilterEvaluate(filter, obj) ? SafeCastVerdictYes : SafeCastVerdictNo;
+        } else {
+            verdict = SafeCastVerdictAskObject;
+        }
+        SafeCastDecisionTableInsert(&filter->_table, key, NULL, verdict);
+    }
+
+    if (verdict == SafeCastVerdictAskObject) {
+        return SafeCastFilterEvaluate(filter, obj);
+    }
+    return verdict == SafeCastVerdictYes;
+}
+
+@end
@@ -0,0 +1,85 @@
+//
+//  SafeCastFiltering.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#undef SAFE_CAST_FILTER
+#define SAFE_CAST_FILTER(criterion) -(SAFE_CAST_FILTER_RESULT_CLASS *)safe_objects ## criterion {\
+SAFE_CAST_TEST_SETUP \
+SafeCastObjectBuffer matches;\
+SafeCastObjectBufferInit(&matches);\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if SAFE_CAST_TEST {SafeCastObjectBufferAppend(&matches, obj);}\
+SAFE_CAST_BATCH_END\
+SAFE_CAST_FILTER_RESULT_CLASS *result = [SAFE_CAST_FILTER_RESULT_CLASS SAFE_CAST_FILTER_RESULT_FACTORY:matches.objects count:matches.count];\
+SafeCastObjectBufferFree(&matches);\
+return result;}
+
+#undef SAFE_CAST_KEYED_FILTER
+#define SAFE_CAST_KEYED_FILTER(criterion) -(NSDictionary *)safe_keysAndObjects ## criterion {\
+SAFE_CAST_TEST_SETUP \
+NSUInteger count = self.count;\
+SafeCastObjectBuffer keys, objects;\
+SafeCastObjectBufferInitWithCapacity(&keys, count);\
+SafeCastObjectBufferInitWithCapacity(&objects, count);\
+[self getObjects:objects.objects andKeys:keys.objects count:count];\
+for (NSUInteger i = 0; i < count; i++) {\
+__unsafe_unretained id obj = objects.objects[i];\
+if SAFE_CAST_TEST {keys.objects[objects.count] = keys.objects[i]; objects.objects[objects.count++] = obj;}}\
+NSDictionary *result = [NSDictionary dictionaryWithObjects:objects.objects forKeys:keys.objects count:objects.count];\
+SafeCastObjectBufferFree(&keys);\
+SafeCastObjectBufferFree(&objects);\
+return result;}
+
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_FILTER_DEFINITION SAFE_CAST_KEYED_FILTER
+#else
+#define SAFE_CAST_FILTER_DEFINITION SAFE_CAST_FILTER
+#endif
+
+#pragma mark - Kind of Class
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_FILTER_DEFINITION(OfKind:(Class)class)
+
+#pragma mark - Protocols
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_FILTER_DEFINITION(ConformingToProtocol:(Protocol *)protocol)
+
+#pragma mark - Selectors
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_FILTER_DEFINITION(RespondingToSelector:(SEL)selector)
+
+#undef SAFE_CAST_FILTER_DEFINITION
+#undef SAFE_CAST_TEST_SETUP
@@ -0,0 +1,83 @@
+//
+//  SafeCastFunctionEnumeration.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Function enumeration calls the caller's function directly for each matching element, with unretained references.
+// Collections are walked in fast-enumeration batches; dictionaries walk their keys and look each object up into a
+// strong local, so values a dictionary creates on demand stay alive while the function runs.
+
+#undef SAFE_CAST_FUNCTION_PRECONDITION
+#define SAFE_CAST_FUNCTION_PRECONDITION if (function == NULL) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Function passed to %@ must not be NULL", NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}
+
+#undef SAFE_CAST_FUNCTION_ENUMERATE
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_FUNCTION_ENUMERATE(criterion) -(void)safe_enumerateKeysAndObjects ## criterion function:(SAFE_CAST_ENUMERATE_FUNCTION_TYPE)function context:(void *)context {\
+SAFE_CAST_FUNCTION_PRECONDITION \
+SAFE_CAST_TEST_SETUP \
+BOOL stop = NO;\
+SAFE_CAST_BATCH_BEGIN(self, key)\
+id obj = [self objectForKey:key];\
+if SAFE_CAST_TEST {\
+function(key, obj, &stop, context);\
+if (stop) SAFE_CAST_BATCH_BREAK}\
+SAFE_CAST_BATCH_END}
+#else
+#define SAFE_CAST_FUNCTION_ENUMERATE(criterion) -(void)safe_enumerateObjects ## criterion function:(SAFE_CAST_ENUMERATE_FUNCTION_TYPE)function context:(void *)context {\
+SAFE_CAST_FUNCTION_PRECONDITION \
+SAFE_CAST_TEST_SETUP \
+BOOL stop = NO;\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if SAFE_CAST_TEST {\
+function(SAFE_CAST_ENUMERATE_FUNCTION_ARGUMENTS);\
+if (stop) SAFE_CAST_BATCH_BREAK}\
+SAFE_CAST_BATCH_END}
+#endif
+
+#pragma mark - Kind of Class
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_FUNCTION_ENUMERATE(OfKind:(Class)class)
+
+#pragma mark - Protocols
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_FUNCTION_ENUMERATE(ConformingToProtocol:(Protocol *)protocol)
+
+#pragma mark - Selectors
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_FUNCTION_ENUMERATE(RespondingToSelector:(SEL)selector)
+
+#undef SAFE_CAST_TEST_SETUP
@@ -0,0 +1,58 @@
+//
+//  SafeCastIndexSetBuilder.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/*
+ Builds an NSIndexSet from indexes supplied in ascending order, coalescing runs of consecutive indexes so that the index set receives one -addIndexesInRange: per run rather than one -addIndex: per match.
+
+ NSIndexSet stores ranges, so an isolated match costs one range whichever way it is added; contiguous matches collapse into a single range without touching the index set until the run ends.
+ */
+
+typedef struct SafeCastIndexRun {
+    NSUInteger location;
+    NSUInteger length;
+} SafeCastIndexRun;
+
+static inline void SafeCastIndexRunFlush(SafeCastIndexRun *run, NSMutableIndexSet *indexes)
+{
+    if (run->length > 0) {
+        [indexes addIndexesInRange:NSMakeRange(run->location, run->length)];
+        run->length = 0;
+    }
+}
+
+static inline void SafeCastIndexRunAdd(SafeCastIndexRun *run, NSMutableIndexSet *indexes, NSUInteger index)
+{
+    if (run->length > 0 && run->location + run->length == index) {
+        run->length++;
+        return;
+    }
+    SafeCastIndexRunFlush(run, indexes);
+    run->location = index;
+    run->length = 1;
+}
@@ -27,16 +27,52 @@
 
 #undef SAFE_CAST_TEST
 
-#define SAFE_CAST_INDEXED_ENUMERATION [self enumerateObjectsAtIndexes:indexSet \
-options:opts usingBlock:^SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE \
-{if SAFE_CAST_TEST {block(obj, idx, stop);}}];
+// Indexed enumeration walks each range of the index set in batches copied out with -getObjects:range:, so the
+// caller's block is called directly for each matching element. Concurrent enumeration copies the indexes out once.
+#define SAFE_CAST_INDEXED_ENUMERATION SAFE_CAST_BLOCK_PRECONDITION SAFE_CAST_TEST_SETUP \
+if (indexSet.count > 0 && indexSet.lastIndex >= self.count) {[[[NSException alloc] initWithName:NSRangeException \
+reason:[NSString stringWithFormat: @"Index %lu passed to %@ is beyond the bounds of a collection of %lu objects", (unsigned long)indexSet.lastIndex, NSStringFromSelector(_cmd), (unsigned long)self.count]\
+userInfo:nil] raise];}\
+if (opts & NSEnumerationConcurrent) {\
+NSUInteger count = indexSet.count;\
+NSUInteger *indexes = (NSUInteger *)malloc(MAX(count, (NSUInteger)1) * sizeof(NSUInteger));\
+[indexSet getIndexes:indexes maxCount:count inIndexRange:NULL];\
+SafeCastApplyChunks(count, 0, ^(NSRange range, SafeCastStopFlag *stop) {\
+for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {\
+if (SafeCastShouldStop(stop)) {return;}\
+NSUInteger idx = indexes[i];\
+__unsafe_unretained id obj = [self objectAtIndex:idx];\
+if SAFE_CAST_TEST {\
+BOOL stopEnumerating = NO;\
+block(obj, idx, &stopEnumerating);\
+if (stopEnumerating) {SafeCastStop(stop); return;}}}});\
+free(indexes);\
+} else {\
+BOOL reverse = (opts & NSEnumerationReverse) != 0;\
+[indexSet enumerateRangesWithOptions:(opts & NSEnumerationReverse) usingBlock:^(NSRange range, BOOL *stopRanges) {\
+BOOL stop = NO;\
+SAFE_CAST_RANGE_BEGIN(self, range, reverse, obj)\
+if SAFE_CAST_TEST {\
+block(obj, SAFE_CAST_RANGE_INDEX, &stop);\
+if (stop) SAFE_CAST_RANGE_BREAK}\
+SAFE_CAST_RANGE_END\
+*stopRanges = stop;}];}
 
-#define SAFE_CAST_INDEXES_OF_OBJECTS return [self indexesOfObjectsPassingTest:^SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE {\
-return SAFE_CAST_TEST;}];
+// Matching indexes arrive in ascending order, so runs of matches are added to the result as whole ranges.
+#define SAFE_CAST_INDEXES_OF_OBJECTS SAFE_CAST_TEST_SETUP \
+NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];\
+SafeCastIndexRun run = {0, 0};\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if SAFE_CAST_TEST {SafeCastIndexRunAdd(&run, indexes, SAFE_CAST_BATCH_INDEX);}\
+SAFE_CAST_BATCH_END\
+SafeCastIndexRunFlush(&run, indexes);\
+return [indexes copy];
 
 #pragma mark - Kind of Class
 #undef SAFE_CAST_TEST
-#define SAFE_CAST_TEST ([obj isKindOfClass:class])
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
 
 - (void)safe_enumerateObjectsOfKind:(Class)class atIndexes:(NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(void (^)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)block
 {SAFE_CAST_INDEXED_ENUMERATION}
@@ -45,7 +81,7 @@ return SAFE_CAST_TEST;}];
 
 #pragma mark - Protocols
 #undef SAFE_CAST_TEST
-#define SAFE_CAST_TEST ([obj conformsToProtocol:protocol])
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
 
 - (void)safe_enumerateObjectsConformingToProtocol:(Protocol *)protocol atIndexes:(NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(void (^)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)block
 {SAFE_CAST_INDEXED_ENUMERATION}
@@ -59,3 +95,28 @@ return SAFE_CAST_TEST;}];
 - (void)safe_enumerateObjectsRespondingToSelector:(SEL)selector atIndexes:(NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(void (^)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)block
 {SAFE_CAST_INDEXED_ENUMERATION}
 
+- (NSIndexSet *)safe_indexesOfObjectsRespondingToSelector:(SEL)selector {SAFE_CAST_INDEXES_OF_OBJECTS}
+
+#pragma mark - Kinds of Classes
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SafeCastClassSet *classSet = SafeCastClassSetWithClasses(classes);
+#define SAFE_CAST_TEST (SafeCastClassSetIndexOfObject(classSet, obj) != NSNotFound)
+
+- (void)safe_enumerateObjectsOfKinds:(id<NSFastEnumeration>)classes atIndexes:(NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(void (^)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)block
+{SAFE_CAST_INDEXED_ENUMERATION}
+
+- (NSIndexSet *)safe_indexesOfObjectsOfKinds:(id<NSFastEnumeration>)classes {SAFE_CAST_INDEXES_OF_OBJECTS}
+
+#pragma mark - Filters
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastFilterMatchesObject(filter, obj))
+
+- (void)safe_enumerateObjectsMatchingFilter:(SafeCastFilter *)filter atIndexes:(NSIndexSet *)indexSet options:(NSEnumerationOptions)opts usingBlock:(void (^)SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE)block
+{SAFE_CAST_INDEXED_ENUMERATION}
+
+- (NSIndexSet *)safe_indexesOfObjectsMatchingFilter:(SafeCastFilter *)filter {SAFE_CAST_INDEXES_OF_OBJECTS}
+
+#undef SAFE_CAST_TEST_SETUP
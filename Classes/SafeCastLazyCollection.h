@@ -0,0 +1,50 @@
+//
+//  SafeCastLazyCollection.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+@class SafeCastFilter;
+
+/*
+ Filtered views of an NSArray or NSOrderedSet that do not copy the matching objects.
+
+ A view keeps the source collection and a filter. The first time it is asked for an element or its count, it walks the source in batches and records the source index of each match in an index map, going only as far as the request needs. Later requests continue from where the last one stopped, and once the whole source has been walked the map is read without taking a lock. Fast enumeration does not use the map at all; it compacts matching objects from the source straight into the loop's buffer.
+
+ Views keep their source rather than a copy of it, so making a view of a mutable collection costs nothing. The source must not be mutated while a view of it is in use: every access checks the source's mutation counter against the value it had when the view was made, and raises NSGenericException if it has changed. A view of an empty mutable source checks the source's count instead, since an empty collection has no mutation counter to watch. Copying a view of a mutable source returns an immutable array or ordered set of the matching objects; a view of an immutable source is its own copy. Views are immutable and safe to use from multiple threads at once, as long as the source is not mutated.
+ */
+
+@interface SafeCastLazyArray : NSArray
+
+- (nonnull instancetype)initWithSource:(nonnull NSArray *)source filter:(nonnull SafeCastFilter *)filter;
+
+@end
+
+@interface SafeCastLazyOrderedSet : NSOrderedSet
+
+- (nonnull instancetype)initWithSource:(nonnull NSOrderedSet *)source filter:(nonnull SafeCastFilter *)filter;
+
+@end
@@ -0,0 +1,360 @@
+//
+//  SafeCastLazyCollection.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastLazyCollection.h"
+#import "SafeCastFilter.h"
+#import "SafeCastDecisionCache.h"
+#import "SafeCastBatch.h"
+#import <pthread.h>
+
+#define SAFE_CAST_INDEX_MAP_INITIAL_CAPACITY 16
+
+/*
+ The source indexes of matching objects, in ascending order, for the part of the source walked so far.
+
+ Extending the map and reading it before it is complete happen under the lock. Once `complete` is set, nothing writes to the map again, so readers that observe it with acquire ordering skip the lock.
+ */
+typedef struct SafeCastIndexMap {
+    NSUInteger *indexes;
+    NSUInteger count;
+    NSUInteger capacity;
+    NSUInteger scanned;
+    _Atomic(BOOL) complete;
+    pthread_mutex_t lock;
+} SafeCastIndexMap;
+
+static void SafeCastIndexMapInit(SafeCastIndexMap *map)
+{
+    map->indexes = NULL;
+    map->count = 0;
+    map->capacity = 0;
+    map->scanned = 0;
+    atomic_init(&map->complete, NO);
+    pthread_mutex_init(&map->lock, NULL);
+}
+
+static void SafeCastIndexMapDestroy(SafeCastIndexMap *map)
+{
+    free(map->indexes);
+    pthread_mutex_destroy(&map->lock);
+}
+
+static inline BOOL SafeCastIndexMapIsComplete(SafeCastIndexMap *map)
+{
+    return atomic_load_explicit(&map->complete, memory_order_acquire);
+}
+
+// Walks the source until at least `count` matches are mapped or the source is exhausted. Called with the lock held.
+// Returns NO if the map could not grow; the caller raises once it has released the lock.
+static BOOL SafeCastIndexMapExtend(SafeCastIndexMap *map, id source, NSUInteger sourceCount, SafeCastFilter *filter, NSUInteger count)
+{
+    __unsafe_unretained id objects[SAFE_CAST_BATCH_SIZE];
+    while (map->count < count && map->scanned < sourceCount) {
+        NSRange batch = NSMakeRange(map->scanned, MIN((NSUInteger)SAFE_CAST_BATCH_SIZE, sourceCount - map->scanned));
+        [source getObjects:objects range:batch];
+        NSUInteger countBeforeBatch = map->count;
+        for (NSUInteger i = 0; i < batch.length; i++) {
+            if (!SafeCastFilterMatchesObject(filter, objects[i])) {
+                continue;
+            }
+            if (map->count == map->capacity) {
+                NSUInteger capacity = MAX((NSUInteger)SAFE_CAST_INDEX_MAP_INITIAL_CAPACITY, map->capacity * 2);
+                NSUInteger *indexes = (NSUInteger *)realloc(map->indexes, capacity * sizeof(NSUInteger));
+                if (indexes == NULL) {
+                    // Drop this batch's matches so that the next call rescans the batch from its start.
+                    map->count = countBeforeBatch;
+                    return NO;
+                }
+                map->indexes = indexes;
+                map->capacity = capacity;
+            }
+            map->indexes[map->count++] = batch.location + i;
+        }
+        map->scanned = NSMaxRange(batch);
+    }
+    if (map->scanned == sourceCount) {
+        atomic_store_explicit(&map->complete, YES, memory_order_release);
+    }
+    return YES;
+}
+
+static void SafeCastIndexMapRaiseAllocationFailure(SafeCastIndexMap *map)
+{
+    [NSException raise:NSMallocException format:@"SafeCast could not grow the index map of a lazy view beyond %lu matches", (unsigned long)map->capacity];
+}
+
+static NSUInteger SafeCastIndexMapCount(SafeCastIndexMap *map, id source, NSUInteger sourceCount, SafeCastFilter *filter)
+{
+    if (!SafeCastIndexMapIsComplete(map)) {
+        pthread_mutex_lock(&map->lock);
+        BOOL extended = SafeCastIndexMapExtend(map, source, sourceCount, filter, NSUIntegerMax);
+        pthread_mutex_unlock(&map->lock);
+        if (!extended) {
+            SafeCastIndexMapRaiseAllocationFailure(map);
+        }
+    }
+    return map->count;
+}
+
+// Returns the source index of the match at `index`, or NSNotFound if there are not that many matches.
+static NSUInteger SafeCastIndexMapSourceIndex(SafeCastIndexMap *map, id source, NSUInteger sourceCount, SafeCastFilter *filter, NSUInteger index)
+{
+    if (SafeCastIndexMapIsComplete(map)) {
+        return index < map->count ? map->indexes[index] : NSNotFound;
+    }
+    pthread_mutex_lock(&map->lock);
+    BOOL extended = SafeCastIndexMapExtend(map, source, sourceCount, filter, index + 1);
+    NSUInteger sourceIndex = index < map->count ? map->indexes[index] : NSNotFound;
+    pthread_mutex_unlock(&map->lock);
+    if (!extended && sourceIndex == NSNotFound) {
+        SafeCastIndexMapRaiseAllocationFailure(map);
+    }
+    return sourceIndex;
+}
+
+// Returns the position of `sourceIndex` among the matches, or NSNotFound if the object there does not match.
+static NSUInteger SafeCastIndexMapIndexOfSourceIndex(SafeCastIndexMap *map, id source, NSUInteger sourceCount, SafeCastFilter *filter, NSUInteger sourceIndex)
+{
+    BOOL complete = SafeCastIndexMapIsComplete(map);
+    if (!complete) {
+        pthread_mutex_lock(&map->lock);
+        while (map->scanned <= sourceIndex && map->scanned < sourceCount) {
+            if (!SafeCastIndexMapExtend(map, source, sourceCount, filter, map->count + 1)) {
+                pthread_mutex_unlock(&map->lock);
+                SafeCastIndexMapRaiseAllocationFailure(map);
+            }
+        }
+    }
+    NSUInteger low = 0, high = map->count, index = NSNotFound;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (map->indexes[mid] < sourceIndex) {
+            low = mid + 1;
+        } else if (map->indexes[mid] > sourceIndex) {
+            high = mid;
+        } else {
+            index = mid;
+            break;
+        }
+    }
+    if (!complete) {
+        pthread_mutex_unlock(&map->lock);
+    }
+    return index;
+}
+
+// Compacts matching objects from the source into the caller's buffer. state->state is the next source index to read.
+// The loop watches the source's own mutation counter, so mutating the source inside the loop raises as it would for the source.
+static NSUInteger SafeCastLazyEnumerate(id source, NSUInteger sourceCount, SafeCastFilter *filter, unsigned long *mutationsPtr, NSFastEnumerationState *state, __unsafe_unretained id *buffer, NSUInteger len)
+{
+    if (state->state == 0) {
+        state->mutationsPtr = mutationsPtr;
+    }
+    NSUInteger count = 0;
+    NSUInteger position = state->state;
+    while (count == 0 && position < sourceCount && len > 0) {
+        NSRange batch = NSMakeRange(position, MIN(len, sourceCount - position));
+        [source getObjects:buffer range:batch];
+        for (NSUInteger i = 0; i < batch.length; i++) {
+            if (SafeCastFilterMatchesObject(filter, buffer[i])) {
+                buffer[count++] = buffer[i];
+            }
+        }
+        position = NSMaxRange(batch);
+    }
+    state->state = position;
+    state->itemsPtr = buffer;
+    return count;
+}
+
+/*
+ The mutation counter of a view's source, as fast enumeration sees it when the view is made. Views keep their source rather than a copy, so every access first checks that the source has not been mutated since.
+
+ An empty collection hands out no mutation counter, so for an empty mutable source the guard watches its count instead: anything added to it is a mutation.
+ */
+typedef struct SafeCastSourceGuard {
+    NSFastEnumerationState state;
+    unsigned long *mutationsPtr;
+    unsigned long mutations;
+    __unsafe_unretained id source;
+    BOOL sourceIsMutable;
+    BOOL watchesCount;
+} SafeCastSourceGuard;
+
+static void SafeCastSourceGuardInit(SafeCastSourceGuard *guard, id source, BOOL sourceIsMutable)
+{
+    memset(&guard->state, 0, sizeof(guard->state));
+    guard->mutationsPtr = SafeCastMutationsPointer(source, &guard->state);
+    guard->mutations = *guard->mutationsPtr;
+    guard->source = source;
+    guard->sourceIsMutable = sourceIsMutable;
+    guard->watchesCount = sourceIsMutable && [source count] == 0;
+}
+
+static inline void SafeCastSourceGuardCheck(SafeCastSourceGuard *guard, id view, SEL _cmd)
+{
+    if (*guard->mutationsPtr != guard->mutations || (guard->watchesCount && [guard->source count] != 0)) {
+        [[[NSException alloc] initWithName:NSGenericException
+                                    reason:[NSString stringWithFormat:@"-[%@ %@]: the source collection was mutated after the view was made", NSStringFromClass([view class]), NSStringFromSelector(_cmd)]
+                                  userInfo:nil] raise];
+    }
+}
+
+static void SafeCastRaiseRangeException(id view, SEL _cmd, NSUInteger index)
+{
+    [[[NSException alloc] initWithName:NSRangeException
+                                reason:[NSString stringWithFormat:@"-[%@ %@]: index %lu beyond bounds", NSStringFromClass([view class]), NSStringFromSelector(_cmd), (unsigned long)index]
+                              userInfo:nil] raise];
+}
+
+@implementation SafeCastLazyArray {
+    NSArray *_source;
+    NSUInteger _sourceCount;
+    SafeCastSourceGuard _guard;
+    SafeCastFilter *_filter;
+    SafeCastIndexMap _map;
+}
+
+- (instancetype)initWithSource:(NSArray *)source filter:(SafeCastFilter *)filter
+{
+    self = [super init];
+    if (self) {
+        _source = source;
+        _sourceCount = source.count;
+        SafeCastSourceGuardInit(&_guard, source, [source isKindOfClass:[NSMutableArray class]]);
+        _filter = filter;
+        SafeCastIndexMapInit(&_map);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    SafeCastIndexMapDestroy(&_map);
+}
+
+- (NSUInteger)count
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    return SafeCastIndexMapCount(&_map, _source, _sourceCount, _filter);
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    NSUInteger sourceIndex = SafeCastIndexMapSourceIndex(&_map, _source, _sourceCount, _filter, index);
+    if (sourceIndex == NSNotFound) {
+        SafeCastRaiseRangeException(self, _cmd, index);
+    }
+    return [_source objectAtIndex:sourceIndex];
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    return SafeCastLazyEnumerate(_source, _sourceCount, _filter, _guard.mutationsPtr, state, buffer, len);
+}
+
+// A view of a mutable source is tied to it, so only a view of an immutable source is its own immutable copy.
+- (id)copyWithZone:(NSZone *)zone
+{
+    if (!_guard.sourceIsMutable) {
+        return self;
+    }
+    return [[NSArray alloc] initWithArray:self];
+}
+
+@end
+
+@implementation SafeCastLazyOrderedSet {
+    NSOrderedSet *_source;
+    NSUInteger _sourceCount;
+    SafeCastSourceGuard _guard;
+    SafeCastFilter *_filter;
+    SafeCastIndexMap _map;
+}
+
+- (instancetype)initWithSource:(NSOrderedSet *)source filter:(SafeCastFilter *)filter
+{
+    self = [super init];
+    if (self) {
+        _source = source;
+        _sourceCount = source.count;
+        SafeCastSourceGuardInit(&_guard, source, [source isKindOfClass:[NSMutableOrderedSet class]]);
+        _filter = filter;
+        SafeCastIndexMapInit(&_map);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    SafeCastIndexMapDestroy(&_map);
+}
+
+- (NSUInteger)count
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    return SafeCastIndexMapCount(&_map, _source, _sourceCount, _filter);
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    NSUInteger sourceIndex = SafeCastIndexMapSourceIndex(&_map, _source, _sourceCount, _filter, index);
+    if (sourceIndex == NSNotFound) {
+        SafeCastRaiseRangeException(self, _cmd, index);
+    }
+    return [_source objectAtIndex:sourceIndex];
+}
+
+- (NSUInteger)indexOfObject:(id)object
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    NSUInteger sourceIndex = [_source indexOfObject:object];
+    if (sourceIndex == NSNotFound) {
+        return NSNotFound;
+    }
+    return SafeCastIndexMapIndexOfSourceIndex(&_map, _source, _sourceCount, _filter, sourceIndex);
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+    SafeCastSourceGuardCheck(&_guard, self, _cmd);
+    return SafeCastLazyEnumerate(_source, _sourceCount, _filter, _guard.mutationsPtr, state, buffer, len);
+}
+
+// A view of a mutable source is tied to it, so only a view of an immutable source is its own immutable copy.
+- (id)copyWithZone:(NSZone *)zone
+{
+    if (!_guard.sourceIsMutable) {
+        return self;
+    }
+    return [[NSOrderedSet alloc] initWithOrderedSet:self];
+}
+
+@end
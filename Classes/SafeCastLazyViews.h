@@ -0,0 +1,42 @@
+//
+//  SafeCastLazyViews.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Lazy views share the receiver instead of copying the matching objects; see SafeCastLazyCollection.h.
+
+#undef SAFE_CAST_LAZY_VIEW_SELECTOR_PASTE
+#define SAFE_CAST_LAZY_VIEW_SELECTOR_PASTE(name, criterion) safe_ ## name ## criterion
+#undef SAFE_CAST_LAZY_VIEW_SELECTOR
+#define SAFE_CAST_LAZY_VIEW_SELECTOR(name, criterion) SAFE_CAST_LAZY_VIEW_SELECTOR_PASTE(name, criterion)
+
+#undef SAFE_CAST_LAZY_VIEW
+#define SAFE_CAST_LAZY_VIEW(criterion, parameter, makeFilter) -(SAFE_CAST_FILTER_RESULT_CLASS *)SAFE_CAST_LAZY_VIEW_SELECTOR(SAFE_CAST_LAZY_VIEW_NAME, criterion):parameter {\
+return [[SAFE_CAST_LAZY_VIEW_CLASS alloc] initWithSource:self filter:makeFilter];}
+
+SAFE_CAST_LAZY_VIEW(OfKind, (Class)class, [SafeCastFilter filterOfKind:class])
+SAFE_CAST_LAZY_VIEW(ConformingToProtocol, (Protocol *)protocol, [SafeCastFilter filterConformingToProtocol:protocol])
+SAFE_CAST_LAZY_VIEW(RespondingToSelector, (SEL)selector, [SafeCastFilter filterRespondingToSelector:selector])
+SAFE_CAST_LAZY_VIEW(MatchingFilter, (SafeCastFilter *)filter, filter)
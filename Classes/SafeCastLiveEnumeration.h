@@ -0,0 +1,147 @@
+//
+//  SafeCastLiveEnumeration.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Enumeration of pointer collections (NSHashTable, NSMapTable and NSPointerArray) that may hold weak references.
+// Each batch pulled with -countByEnumeratingWithState:objects:count: is copied into strong references before any
+// test or block runs, so an object cannot be deallocated while it is being used. Entries that have been zeroed are
+// skipped. Map tables look up a whole batch of values inside a single autorelease pool rather than one per element.
+// Entries are read from itemsPtr as plain loads, exactly as a for-in loop would read them, so weak entries are only
+// safe against deallocation on the enumerating thread. Every entry is assumed to be an object; collections with opaque
+// or integer personalities are not supported.
+
+#undef SAFE_CAST_LIVE_BEGIN
+#undef SAFE_CAST_LIVE_END
+#undef SAFE_CAST_LIVE_BREAK
+#undef SAFE_CAST_LIVE_EXTRACT
+#undef SAFE_CAST_LIVE_KEY
+#undef SAFE_CAST_LIVE_KEY_STORAGE
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_LIVE_EXTRACT @autoreleasepool {\
+for (NSUInteger safeCastI = 0; safeCastI < safeCastBatchCount; safeCastI++) {\
+safeCastKeys[safeCastI] = safeCastState.itemsPtr[safeCastI];\
+safeCastObjects[safeCastI] = safeCastKeys[safeCastI] ? [self objectForKey:safeCastKeys[safeCastI]] : nil;}}
+#define SAFE_CAST_LIVE_KEY_STORAGE __strong id safeCastKeys[SAFE_CAST_BATCH_SIZE];
+#define SAFE_CAST_LIVE_KEY __unsafe_unretained id key = safeCastKeys[safeCastI]; (void)key;
+#else
+#define SAFE_CAST_LIVE_EXTRACT for (NSUInteger safeCastI = 0; safeCastI < safeCastBatchCount; safeCastI++) {\
+safeCastObjects[safeCastI] = safeCastState.itemsPtr[safeCastI];}
+#define SAFE_CAST_LIVE_KEY_STORAGE
+#define SAFE_CAST_LIVE_KEY
+#endif
+
+#define SAFE_CAST_LIVE_BEGIN {\
+NSFastEnumerationState safeCastState = {0};\
+__unsafe_unretained id safeCastBatch[SAFE_CAST_BATCH_SIZE];\
+SAFE_CAST_LIVE_KEY_STORAGE \
+__strong id safeCastObjects[SAFE_CAST_BATCH_SIZE];\
+NSUInteger safeCastBatchCount = 0;\
+unsigned long safeCastMutations = 0;\
+BOOL safeCastStarted = NO;\
+BOOL safeCastDone = NO;\
+while (!safeCastDone && (safeCastBatchCount = [self countByEnumeratingWithState:&safeCastState objects:safeCastBatch count:SAFE_CAST_BATCH_SIZE]) > 0) {\
+if (!safeCastStarted) {safeCastMutations = *safeCastState.mutationsPtr; safeCastStarted = YES;}\
+SAFE_CAST_LIVE_EXTRACT \
+for (NSUInteger safeCastI = 0; !safeCastDone && safeCastI < safeCastBatchCount; safeCastI++) {\
+if (*safeCastState.mutationsPtr != safeCastMutations) {objc_enumerationMutation(self);}\
+__unsafe_unretained id obj = safeCastObjects[safeCastI];\
+if (obj == nil) {continue;}\
+SAFE_CAST_LIVE_KEY
+
+#define SAFE_CAST_LIVE_END }}}
+
+#define SAFE_CAST_LIVE_BREAK {safeCastDone = YES; continue;}
+
+#pragma mark - Perform Selector
+
+#undef SAFE_CAST_LIVE_PERFORM
+#define SAFE_CAST_LIVE_PERFORM -(void)safe_makeObjectsSafelyPerformSelector:(SEL)aSelector SAFE_CAST_WITH_OBJECT {\
+if (aSelector == NULL) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Selector passed to %@ must not be nil", NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}\
+SafeCastIMPMemo memo = {aSelector};\
+SAFE_CAST_LIVE_BEGIN \
+IMP imp = SafeCastIMPMemoLookup(&memo, obj);\
+if (imp) {SAFE_CAST_CALL_IMP;}\
+SAFE_CAST_LIVE_END}
+
+#undef SAFE_CAST_WITH_OBJECT
+#undef SAFE_CAST_CALL_IMP
+#define SAFE_CAST_WITH_OBJECT
+#define SAFE_CAST_CALL_IMP ((void (*)(id, SEL))imp)(obj, aSelector)
+SAFE_CAST_LIVE_PERFORM
+
+#undef SAFE_CAST_WITH_OBJECT
+#undef SAFE_CAST_CALL_IMP
+#define SAFE_CAST_WITH_OBJECT withObject:(id)anObject
+#define SAFE_CAST_CALL_IMP ((void (*)(id, SEL, id))imp)(obj, aSelector, anObject)
+SAFE_CAST_LIVE_PERFORM
+
+#pragma mark - Enumeration
+
+#undef SAFE_CAST_LIVE_ENUMERATE
+#ifdef SAFE_CAST_KEYED_ENUMERATION
+#define SAFE_CAST_LIVE_ENUMERATE(criterion) -(void)safe_enumerateKeysAndObjects ## criterion usingBlock:(void (^)(id key, id obj, BOOL *stop))block {\
+SAFE_CAST_BLOCK_PRECONDITION \
+SAFE_CAST_TEST_SETUP \
+BOOL stop = NO;\
+SAFE_CAST_LIVE_BEGIN \
+if SAFE_CAST_TEST {\
+block(key, obj, &stop);\
+if (stop) SAFE_CAST_LIVE_BREAK}\
+SAFE_CAST_LIVE_END}
+#else
+#define SAFE_CAST_LIVE_ENUMERATE(criterion) -(void)safe_enumerateObjects ## criterion usingBlock:(void (^)(id obj, BOOL *stop))block {\
+SAFE_CAST_BLOCK_PRECONDITION \
+SAFE_CAST_TEST_SETUP \
+BOOL stop = NO;\
+SAFE_CAST_LIVE_BEGIN \
+if SAFE_CAST_TEST {\
+block(obj, &stop);\
+if (stop) SAFE_CAST_LIVE_BREAK}\
+SAFE_CAST_LIVE_END}
+#endif
+
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_LIVE_ENUMERATE(OfKind:(Class)class)
+
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_LIVE_ENUMERATE(ConformingToProtocol:(Protocol *)protocol)
+
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_LIVE_ENUMERATE(RespondingToSelector:(SEL)selector)
+
+#undef SAFE_CAST_TEST_SETUP
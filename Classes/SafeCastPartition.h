@@ -0,0 +1,103 @@
+//
+//  SafeCastPartition.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Partitioning walks the collection once, recording the bucket of each element, then scatters the
+// elements into one contiguous, bucket-ordered buffer so each result array is created at its exact size.
+// Everything the walk needs comes from a single allocation, which is freed before a mutation is reported so
+// that objc_enumerationMutation() raising cannot leak it.
+- (NSArray *)safe_partitionObjectsByKinds:(id<NSFastEnumeration>)classes
+{
+    SafeCastClassSet *classSet = SafeCastClassSetWithClasses(classes);
+    NSUInteger unmatched = classSet.classes.count;
+    NSUInteger bucketCount = unmatched + 1;
+    NSUInteger count = self.count;
+
+    // Laid out as the walked objects, the sorted objects, each object's bucket, then the size of each bucket.
+    size_t storageSize = count * (2 * sizeof(id) + sizeof(NSUInteger)) + bucketCount * sizeof(NSUInteger);
+    void *storage = calloc(1, storageSize);
+    if (storage == NULL) {
+        SafeCastObjectBufferAllocationFailed(count);
+    }
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)storage;
+    __unsafe_unretained id *sorted = objects + count;
+    NSUInteger *buckets = (NSUInteger *)(sorted + count);
+    NSUInteger *bucketSizes = buckets + count;
+
+    NSFastEnumerationState state = {0};
+    __unsafe_unretained id batch[SAFE_CAST_BATCH_SIZE];
+    NSUInteger batchCount = 0;
+    NSUInteger walked = 0;
+    unsigned long mutations = 0;
+    BOOL mutated = NO;
+    while (!mutated && walked < count && (batchCount = [self countByEnumeratingWithState:&state objects:batch count:SAFE_CAST_BATCH_SIZE]) > 0) {
+        if (walked == 0) {
+            mutations = *state.mutationsPtr;
+        }
+        for (NSUInteger i = 0; i < batchCount && walked < count; i++, walked++) {
+            if (*state.mutationsPtr != mutations) {
+                mutated = YES;
+                break;
+            }
+            __unsafe_unretained id obj = state.itemsPtr[i];
+            NSUInteger bucket = SafeCastClassSetIndexOfObject(classSet, obj);
+            if (bucket == NSNotFound) {
+                bucket = unmatched;
+            }
+            objects[walked] = obj;
+            buckets[walked] = bucket;
+            bucketSizes[bucket]++;
+        }
+    }
+    if (mutated) {
+        free(storage);
+        objc_enumerationMutation(self);
+        // A mutation handler returned instead of raising, so partition the collection as it is now.
+        return [self safe_partitionObjectsByKinds:classes];
+    }
+
+    // Turn sizes into starting offsets in place, place each element after those before it in its bucket, and
+    // the offsets end up as each bucket's end.
+    NSUInteger offset = 0;
+    for (NSUInteger b = 0; b < bucketCount; b++) {
+        NSUInteger size = bucketSizes[b];
+        bucketSizes[b] = offset;
+        offset += size;
+    }
+    for (NSUInteger i = 0; i < walked; i++) {
+        sorted[bucketSizes[buckets[i]]++] = objects[i];
+    }
+
+    NSMutableArray *partitions = [NSMutableArray arrayWithCapacity:bucketCount];
+    offset = 0;
+    for (NSUInteger b = 0; b < bucketCount; b++) {
+        [partitions addObject:[NSArray arrayWithObjects:sorted + offset count:bucketSizes[b] - offset]];
+        offset = bucketSizes[b];
+    }
+
+    free(storage);
+    return [partitions copy];
+}
@@ -26,21 +26,24 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #undef SAFE_CAST_WITH_OBJECT
+#undef SAFE_CAST_CALL_IMP
 #undef SAFE_CAST_PERFORM
 #define SAFE_CAST_PERFORM -(void)safe_makeObjectsSafelyPerformSelector:(SEL)aSelector SAFE_CAST_WITH_OBJECT {\
 if (aSelector == NULL) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
 reason:[NSString stringWithFormat: @"Selector passed to %@ must not be nil", NSStringFromSelector(_cmd)]\
 userInfo:nil] raise];}\
-[self enumerateObjectsUsingBlock:^SAFE_CAST_ENUMERATE_BLOCK_SIGNATURE {\
-if ([obj respondsToSelector:aSelector]) {[obj performSelector:aSelector SAFE_CAST_WITH_OBJECT];}}];}
+SafeCastIMPMemo memo = {aSelector};\
+for (id obj in self) {\
+IMP imp = SafeCastIMPMemoLookup(&memo, obj);\
+if (imp) {SAFE_CAST_CALL_IMP;}}}
 
 #undef SAFE_CAST_WITH_OBJECT
 #define SAFE_CAST_WITH_OBJECT
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
+#define SAFE_CAST_CALL_IMP ((void (*)(id, SEL))imp)(obj, aSelector)
 SAFE_CAST_PERFORM
 
 #undef SAFE_CAST_WITH_OBJECT
+#undef SAFE_CAST_CALL_IMP
 #define SAFE_CAST_WITH_OBJECT withObject:(id)anObject
+#define SAFE_CAST_CALL_IMP ((void (*)(id, SEL, id))imp)(obj, aSelector, anObject)
 SAFE_CAST_PERFORM
-#pragma clang diagnostic pop
@@ -0,0 +1,160 @@
+//
+//  SafeCastReduction.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Reductions and compact-maps over the matching objects of an indexed collection.
+// Concurrent forms split the collection into chunks with SafeCastApplyChunks(). Each chunk reduces into its own
+// partial accumulator, or maps into its own result array, so workers never share state.
+
+#undef SAFE_CAST_REQUIRE_BLOCK
+#define SAFE_CAST_REQUIRE_BLOCK(block) if (block == nil) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Block passed to %@ must not be nil", NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}
+
+#undef SAFE_CAST_EFFECTIVE_GRAIN_SIZE
+#define SAFE_CAST_EFFECTIVE_GRAIN_SIZE(count, grainSize) ((grainSize) > 0 ? (grainSize) : SafeCastDefaultGrainSize(count, [[NSProcessInfo processInfo] activeProcessorCount]))
+
+#undef SAFE_CAST_CHUNK_BEGIN
+#define SAFE_CAST_CHUNK_BEGIN(range, obj) {\
+__unsafe_unretained id safeCastChunkObjects[SAFE_CAST_BATCH_SIZE];\
+for (NSUInteger safeCastLocation = range.location; safeCastLocation < NSMaxRange(range); safeCastLocation += SAFE_CAST_BATCH_SIZE) {\
+NSRange safeCastBatch = NSMakeRange(safeCastLocation, MIN((NSUInteger)SAFE_CAST_BATCH_SIZE, NSMaxRange(range) - safeCastLocation));\
+[self getObjects:safeCastChunkObjects range:safeCastBatch];\
+for (NSUInteger safeCastI = 0; safeCastI < safeCastBatch.length; safeCastI++) {\
+__unsafe_unretained id obj = safeCastChunkObjects[safeCastI];
+
+#undef SAFE_CAST_CHUNK_END
+#define SAFE_CAST_CHUNK_END }}}
+
+#undef SAFE_CAST_REDUCE
+#define SAFE_CAST_REDUCE(criterion) -(id)safe_reduceObjects ## criterion initial:(id)initial combine:(id (^)(id accumulator, id obj))combine merge:(id (^)(id left, id right))merge {\
+SAFE_CAST_REQUIRE_BLOCK(combine)\
+SAFE_CAST_TEST_SETUP \
+id accumulator = initial;\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if SAFE_CAST_TEST {accumulator = combine(accumulator, obj);}\
+SAFE_CAST_BATCH_END \
+return accumulator;}
+
+// Each chunk keeps its partial accumulator in its own one-element array, empty for nil, so workers share no storage
+// and nothing is left to free by hand if a block raises. Partials are merged pairwise, neighbors first, so merge only
+// has to be associative.
+#undef SAFE_CAST_REDUCE_CONCURRENTLY
+#define SAFE_CAST_REDUCE_CONCURRENTLY(criterion) -(id)safe_reduceObjects ## criterion concurrentlyWithGrainSize:(NSUInteger)grainSize initial:(id)initial combine:(id (^)(id accumulator, id obj))combine merge:(id (^)(id left, id right))merge {\
+SAFE_CAST_REQUIRE_BLOCK(combine)\
+SAFE_CAST_REQUIRE_BLOCK(merge)\
+NSUInteger count = self.count;\
+if (count == 0) {return initial;}\
+NSUInteger grain = SAFE_CAST_EFFECTIVE_GRAIN_SIZE(count, grainSize);\
+NSUInteger chunkCount = count / grain + (count % grain ? 1 : 0);\
+NSMutableArray *partials = [NSMutableArray arrayWithCapacity:chunkCount];\
+for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {[partials addObject:[NSMutableArray arrayWithCapacity:1]];}\
+SafeCastApplyChunks(count, grain, ^(NSRange range, SafeCastStopFlag *stop) {\
+SAFE_CAST_TEST_SETUP \
+id accumulator = initial;\
+SAFE_CAST_CHUNK_BEGIN(range, obj)\
+if SAFE_CAST_TEST {accumulator = combine(accumulator, obj);}\
+SAFE_CAST_CHUNK_END \
+if (accumulator != nil) {[partials[range.location / grain] addObject:accumulator];}});\
+for (NSUInteger stride = 1; stride < chunkCount; stride *= 2) {\
+for (NSUInteger i = 0; i + stride < chunkCount; i += 2 * stride) {\
+NSMutableArray *left = partials[i];\
+NSMutableArray *right = partials[i + stride];\
+id merged = merge(left.firstObject, right.firstObject);\
+[left removeAllObjects];\
+[right removeAllObjects];\
+if (merged != nil) {[left addObject:merged];}}}\
+return [partials[0] firstObject];}
+
+#undef SAFE_CAST_COMPACT_MAP
+#define SAFE_CAST_COMPACT_MAP(criterion) -(NSArray *)safe_compactMapObjects ## criterion usingBlock:(id (^)(id obj))block {\
+SAFE_CAST_REQUIRE_BLOCK(block)\
+SAFE_CAST_TEST_SETUP \
+NSMutableArray *results = [NSMutableArray arrayWithCapacity:self.count];\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+if SAFE_CAST_TEST {\
+id result = block(obj);\
+if (result != nil) {[results addObject:result];}}\
+SAFE_CAST_BATCH_END \
+return results;}
+
+// Each chunk maps into its own array, sized for the whole chunk, then the chunks' arrays are joined in order.
+#undef SAFE_CAST_COMPACT_MAP_CONCURRENTLY
+#define SAFE_CAST_COMPACT_MAP_CONCURRENTLY(criterion) -(NSArray *)safe_compactMapObjects ## criterion concurrentlyWithGrainSize:(NSUInteger)grainSize usingBlock:(id (^)(id obj))block {\
+SAFE_CAST_REQUIRE_BLOCK(block)\
+NSUInteger count = self.count;\
+if (count == 0) {return @[];}\
+NSUInteger grain = SAFE_CAST_EFFECTIVE_GRAIN_SIZE(count, grainSize);\
+NSUInteger chunkCount = count / grain + (count % grain ? 1 : 0);\
+NSMutableArray *chunkResults = [NSMutableArray arrayWithCapacity:chunkCount];\
+for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {[chunkResults addObject:[NSMutableArray arrayWithCapacity:MIN(grain, count - chunk * grain)]];}\
+SafeCastApplyChunks(count, grain, ^(NSRange range, SafeCastStopFlag *stop) {\
+SAFE_CAST_TEST_SETUP \
+NSMutableArray *results = chunkResults[range.location / grain];\
+SAFE_CAST_CHUNK_BEGIN(range, obj)\
+if SAFE_CAST_TEST {\
+id result = block(obj);\
+if (result != nil) {[results addObject:result];}}\
+SAFE_CAST_CHUNK_END});\
+NSUInteger resultCount = 0;\
+for (NSArray *results in chunkResults) {resultCount += results.count;}\
+NSMutableArray *array = [NSMutableArray arrayWithCapacity:resultCount];\
+for (NSArray *results in chunkResults) {[array addObjectsFromArray:results];}\
+return array;}
+
+#pragma mark - Kind of Class
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST_SETUP
+#define SAFE_CAST_TEST (SafeCastIsKindOfClass(obj, class))
+
+SAFE_CAST_REDUCE(OfKind:(Class)class)
+SAFE_CAST_REDUCE_CONCURRENTLY(OfKind:(Class)class)
+SAFE_CAST_COMPACT_MAP(OfKind:(Class)class)
+SAFE_CAST_COMPACT_MAP_CONCURRENTLY(OfKind:(Class)class)
+
+#pragma mark - Protocols
+#undef SAFE_CAST_TEST
+#define SAFE_CAST_TEST (SafeCastConformsToProtocol(obj, protocol))
+
+SAFE_CAST_REDUCE(ConformingToProtocol:(Protocol *)protocol)
+SAFE_CAST_REDUCE_CONCURRENTLY(ConformingToProtocol:(Protocol *)protocol)
+SAFE_CAST_COMPACT_MAP(ConformingToProtocol:(Protocol *)protocol)
+SAFE_CAST_COMPACT_MAP_CONCURRENTLY(ConformingToProtocol:(Protocol *)protocol)
+
+#pragma mark - Selectors
+#undef SAFE_CAST_TEST
+#undef SAFE_CAST_TEST_SETUP
+// The memo is not thread-safe, so each chunk keeps its own.
+#define SAFE_CAST_TEST_SETUP SafeCastIMPMemo memo = {selector};
+#define SAFE_CAST_TEST (SafeCastIMPMemoLookup(&memo, obj) != NULL)
+
+SAFE_CAST_REDUCE(RespondingToSelector:(SEL)selector)
+SAFE_CAST_REDUCE_CONCURRENTLY(RespondingToSelector:(SEL)selector)
+SAFE_CAST_COMPACT_MAP(RespondingToSelector:(SEL)selector)
+SAFE_CAST_COMPACT_MAP_CONCURRENTLY(RespondingToSelector:(SEL)selector)
+
+#undef SAFE_CAST_TEST_SETUP
@@ -0,0 +1,64 @@
+//
+//  SafeCastSelectorMapping.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Only methods that return an object are called: the memo records, next to each class's implementation, whether its
+// return type is an object, so scalar and void methods are skipped instead of having their results retained. Methods
+// in the alloc, new, copy, mutableCopy and init families return +1 objects (and init methods consume their receiver),
+// so they are rejected before the pass.
+// The result is created at the receiver's count up front; a single pass can never produce more results than that.
+
+#undef SAFE_CAST_WITH_OBJECT
+#undef SAFE_CAST_CALL_IMP
+#undef SAFE_CAST_MAP_SELECTOR
+#define SAFE_CAST_MAP_SELECTOR -(NSArray *)safe_mapObjectsPerformingSelector:(SEL)aSelector SAFE_CAST_WITH_OBJECT {\
+if (aSelector == NULL) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Selector passed to %@ must not be nil", NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}\
+if (SafeCastSelectorReturnsRetained(aSelector)) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Selector %@ passed to %@ must not return a retained object", NSStringFromSelector(aSelector), NSStringFromSelector(_cmd)]\
+userInfo:nil] raise];}\
+SafeCastIMPMemo memo = {aSelector};\
+memo.requiresObjectReturn = YES;\
+NSMutableArray *results = [NSMutableArray arrayWithCapacity:self.count];\
+SAFE_CAST_BATCH_BEGIN(self, obj)\
+IMP imp = SafeCastIMPMemoLookup(&memo, obj);\
+if (imp) {\
+id result = SAFE_CAST_CALL_IMP;\
+if (result != nil) {[results addObject:result];}}\
+SAFE_CAST_BATCH_END \
+return results;}
+
+#define SAFE_CAST_WITH_OBJECT
+#define SAFE_CAST_CALL_IMP ((id (*)(id, SEL))imp)(obj, aSelector)
+SAFE_CAST_MAP_SELECTOR
+
+#undef SAFE_CAST_WITH_OBJECT
+#undef SAFE_CAST_CALL_IMP
+#define SAFE_CAST_WITH_OBJECT withObject:(id)anObject
+#define SAFE_CAST_CALL_IMP ((id (*)(id, SEL, id))imp)(obj, aSelector, anObject)
+SAFE_CAST_MAP_SELECTOR
@@ -0,0 +1,108 @@
+//
+//  SafeCastSequence.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ A lazy pipeline of filtering and mapping stages over a collection, run in one pass when a result is asked for.
+
+ Each stage method returns a new sequence and does no work. The terminal methods (toArray, count and forEach:) walk the source once, in batches, passing each element through every stage in order before reading the next one. No intermediate collection is created, so the only allocation is the final result, and a takeFirst: stage ends the walk as soon as it has let its last element through.
+
+ Sequences are immutable and can be shared between threads. A sequence keeps its source, and mutating the source while a terminal method walks it raises an exception. Sources that can hold nil pointers, such as NSPointerArray, have those entries skipped.
+
+ @code
+ NSArray *names = [[[[[SafeCastSequence sequenceWithSource:views]
+                      ofKind:[UILabel class]]
+                     skip:1]
+                    takeFirst:10]
+                   map:^id(UILabel *label) { return label.text; }].toArray;
+ @endcode
+ */
+@interface SafeCastSequence : NSObject
+
+/**
+ Returns a sequence over the objects a for-in loop over the source would produce. Dictionaries produce their keys; use -safe_sequence on a dictionary for its values.
+ */
++ (nonnull instancetype)sequenceWithSource:(nonnull id<NSFastEnumeration>)source;
+
+/**
+ @name Stages
+ */
+
+/**
+ Returns a sequence that passes on only the elements that are a kind of the given class.
+ */
+- (nonnull SafeCastSequence *)ofKind:(nonnull Class)class;
+
+/**
+ Returns a sequence that passes on only the elements that conform to the given protocol.
+ */
+- (nonnull SafeCastSequence *)conformingTo:(nonnull Protocol *)protocol;
+
+/**
+ Returns a sequence that passes on only the elements that respond to the given selector.
+ */
+- (nonnull SafeCastSequence *)respondingTo:(nonnull SEL)selector;
+
+/**
+ Returns a sequence that passes on the result of the block for each element. Elements the block returns nil for are dropped.
+ */
+- (nonnull SafeCastSequence *)map:(nonnull id __nullable (^)(__nonnull id obj))transform;
+
+/**
+ Returns a sequence that passes on at most the first count elements that reach this stage. Reaching the limit ends the walk of the source.
+ */
+- (nonnull SafeCastSequence *)takeFirst:(NSUInteger)count;
+
+/**
+ Returns a sequence that drops the first count elements that reach this stage and passes on the rest.
+ */
+- (nonnull SafeCastSequence *)skip:(NSUInteger)count;
+
+/**
+ @name Running the Sequence
+ */
+
+/**
+ Runs the sequence and returns the elements that come out of it, in order.
+ */
+- (nonnull NSArray *)toArray;
+
+/**
+ Runs the sequence and returns the number of elements that come out of it.
+ */
+- (NSUInteger)count;
+
+/**
+ Runs the sequence and executes the block for each element that comes out of it. Setting *stop to YES ends the walk.
+
+ If the block is nil this method will raise an exception.
+ */
+- (void)forEach:(nonnull void (^)(__nonnull id obj, BOOL * __nonnull stop))block;
+
+@end
@@ -0,0 +1,227 @@
+//
+//  SafeCastSequence.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "SafeCastSequence.h"
+#import "SafeCastDecisionCache.h"
+#import "SafeCastBatch.h"
+
+typedef NS_ENUM(NSUInteger, SafeCastSequenceStageKind) {
+    SafeCastSequenceStageOfKind,
+    SafeCastSequenceStageConformingTo,
+    SafeCastSequenceStageRespondingTo,
+    SafeCastSequenceStageMap,
+    SafeCastSequenceStageTake,
+    SafeCastSequenceStageSkip,
+};
+
+@interface SafeCastSequenceStage : NSObject {
+@public
+    SafeCastSequenceStageKind _kind;
+    Class _class;
+    Protocol *_protocol;
+    SEL _selector;
+    id (^_transform)(id);
+    NSUInteger _limit;
+}
+@end
+
+@implementation SafeCastSequenceStage
+@end
+
+// The per-run form of a stage. Parameters are borrowed from the sequence's stages, which outlive the run, and the
+// selector memo and the counters of take and skip stages belong to the run, so concurrent runs never share them.
+typedef struct SafeCastSequenceStep {
+    SafeCastSequenceStageKind kind;
+    __unsafe_unretained Class cls;
+    __unsafe_unretained Protocol *protocol;
+    SafeCastIMPMemo memo;
+    __unsafe_unretained id (^transform)(id);
+    NSUInteger limit;
+    NSUInteger seen;
+} SafeCastSequenceStep;
+
+@implementation SafeCastSequence {
+    id<NSFastEnumeration> _source;
+    NSArray *_stages;
+    BOOL _maps;
+}
+
++ (instancetype)sequenceWithSource:(id<NSFastEnumeration>)source
+{
+    return [[self alloc] initWithSource:source stages:@[] maps:NO];
+}
+
+- (instancetype)initWithSource:(id<NSFastEnumeration>)source stages:(NSArray *)stages maps:(BOOL)maps
+{
+    self = [super init];
+    if (self) {
+        _source = source;
+        _stages = stages;
+        _maps = maps;
+    }
+    return self;
+}
+
+- (SafeCastSequence *)sequenceByAppendingStage:(SafeCastSequenceStage *)stage
+{
+    return [[SafeCastSequence alloc] initWithSource:_source
+                                             stages:[_stages arrayByAddingObject:stage]
+                                               maps:_maps || stage->_kind == SafeCastSequenceStageMap];
+}
+
+static inline SafeCastSequenceStage *SafeCastSequenceStageMake(SafeCastSequenceStageKind kind)
+{
+    SafeCastSequenceStage *stage = [SafeCastSequenceStage new];
+    stage->_kind = kind;
+    return stage;
+}
+
+#pragma mark - Stages
+
+- (SafeCastSequence *)ofKind:(Class)class
+{
+    SafeCastSequenceStage *stage = SafeCastSequenceStageMake(SafeCastSequenceStageOfKind);
+    stage->_class = class;
+    return [self sequenceByAppendingStage:stage];
+}
+
+- (SafeCastSequence *)conformingTo:(Protocol *)protocol
+{
+    SafeCastSequenceStage *stage = SafeCastSequenceStageMake(SafeCastSequenceStageConformingTo);
+    stage->_protocol = protocol;
+    return [self sequenceByAppendingStage:stage];
+}
+
+- (SafeCastSequence *)respondingTo:(SEL)selector
+{
+    SafeCastSequenceStage *stage = SafeCastSequenceStageMake(SafeCastSequenceStageRespondingTo);
+    stage->_selector = selector;
+    return [self sequenceByAppendingStage:stage];
+}
+
+- (SafeCastSequence *)map:(id (^)(id))transform
+{
+    if (transform == nil) {[[[NSException alloc] initWithName:NSInvalidArgumentException
+                                                        reason:[NSString stringWithFormat: @"Block passed to %@ must not be nil", NSStringFromSelector(_cmd)]
+                                                      userInfo:nil] raise];}
+    SafeCastSequenceStage *stage = SafeCastSequenceStageMake(SafeCastSequenceStageMap);
+    stage->_transform = [transform copy];
+    return [self sequenceByAppendingStage:stage];
+}
+
+- (SafeCastSequence *)takeFirst:(NSUInteger)count
+{
+    SafeCastSequenceStage *stage = SafeCastSequenceStageMake(SafeCastSequenceStageTake);
+    stage->_limit = count;
+    return [self sequenceByAppendingStage:stage];
+}
+
+- (SafeCastSequence *)skip:(NSUInteger)count
+{
+    SafeCastSequenceStage *stage = SafeCastSequenceStageMake(SafeCastSequenceStageSkip);
+    stage->_limit = count;
+    return [self sequenceByAppendingStage:stage];
+}
+
+#pragma mark - Running
+
+/*
+ Walks the source once, sending each element through every stage before reading the next, and runs `emit` with
+ `current` bound to each element that comes out the end. SAFE_CAST_SEQUENCE_STOP inside `emit` ends the walk.
+
+ `current` is unretained unless a map stage has replaced it, in which case `held` keeps the mapped object alive
+ until the next element, so sequences without a map stage do no retain or release per element.
+ */
+#define SAFE_CAST_SEQUENCE_RUN(emit) {\
+NSUInteger stepCount = _stages.count;\
+SafeCastSequenceStep steps[MAX(stepCount, (NSUInteger)1)];\
+for (NSUInteger s = 0; s < stepCount; s++) {\
+SafeCastSequenceStage *stage = _stages[s];\
+steps[s] = (SafeCastSequenceStep){stage->_kind, stage->_class, stage->_protocol, {stage->_selector}, stage->_transform, stage->_limit, 0};\
+}\
+__strong id held = nil;\
+SAFE_CAST_BATCH_BEGIN(_source, obj)\
+if (obj == nil) {continue;}\
+__unsafe_unretained id current = obj;\
+BOOL pass = YES;\
+BOOL last = NO;\
+for (NSUInteger s = 0; pass && s < stepCount; s++) {\
+SafeCastSequenceStep *step = &steps[s];\
+switch (step->kind) {\
+case SafeCastSequenceStageOfKind: pass = SafeCastIsKindOfClass(current, step->cls); break;\
+case SafeCastSequenceStageConformingTo: pass = SafeCastConformsToProtocol(current, step->protocol); break;\
+case SafeCastSequenceStageRespondingTo: pass = SafeCastIMPMemoLookup(&step->memo, current) != NULL; break;\
+case SafeCastSequenceStageMap: held = step->transform(current); current = held; pass = current != nil; break;\
+case SafeCastSequenceStageSkip: if (step->seen < step->limit) {step->seen++; pass = NO;} break;\
+case SafeCastSequenceStageTake:\
+if (step->seen == step->limit) {pass = NO; SAFE_CAST_BATCH_BREAK}\
+if (++step->seen == step->limit) {last = YES;}\
+break;\
+}\
+}\
+if (!pass) {continue;}\
+emit;\
+if (last) SAFE_CAST_BATCH_BREAK \
+SAFE_CAST_BATCH_END \
+}
+
+#define SAFE_CAST_SEQUENCE_STOP SAFE_CAST_BATCH_BREAK
+
+- (NSArray *)toArray
+{
+    if (_maps) {
+        // Mapped objects may exist only in the result, so the result has to retain them as they are produced.
+        NSMutableArray *result = [NSMutableArray array];
+        SAFE_CAST_SEQUENCE_RUN([result addObject:current])
+        return result;
+    }
+    SafeCastObjectBuffer buffer;
+    SafeCastObjectBufferInit(&buffer);
+    SAFE_CAST_SEQUENCE_RUN(SafeCastObjectBufferAppend(&buffer, current))
+    NSArray *result = [NSArray arrayWithObjects:buffer.objects count:buffer.count];
+    SafeCastObjectBufferFree(&buffer);
+    return result;
+}
+
+- (NSUInteger)count
+{
+    NSUInteger count = 0;
+    SAFE_CAST_SEQUENCE_RUN(count++)
+    return count;
+}
+
+- (void)forEach:(void (^)(id, BOOL *))block
+{
+    if (block == nil) {[[[NSException alloc] initWithName:NSInvalidArgumentException
+                                                    reason:[NSString stringWithFormat: @"Block passed to %@ must not be nil", NSStringFromSelector(_cmd)]
+                                                  userInfo:nil] raise];}
+    BOOL stop = NO;
+    SAFE_CAST_SEQUENCE_RUN(block(current, &stop); if (stop) SAFE_CAST_SEQUENCE_STOP)
+}
+
+@end
@@ -0,0 +1,92 @@
+//
+//  SafeCastStreaming.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+@class SafeCastFilter;
+
+/**
+ Type-safe enumeration of any NSFastEnumeration source, including NSEnumerator and its subclasses such as NSDirectoryEnumerator, and custom cursors.
+
+ The source is read in batches with -countByEnumeratingWithState:objects:count: and never copied, so memory use does not grow with the number of objects. Each batch is read and handled inside its own autorelease pool, so objects an enumerator autoreleases as it produces them are released batch by batch instead of accumulating for the whole enumeration. Dictionaries, like for-in, yield their keys.
+
+ Mutating the source while enumerating raises an exception, as it does in a for-in loop. If the block is nil these functions raise an NSInvalidArgumentException.
+
+ @code
+ NSDirectoryEnumerator *files = [[NSFileManager defaultManager] enumeratorAtURL:root includingPropertiesForKeys:nil options:0 errorHandler:nil];
+ SafeCastEnumerateObjectsOfKind(files, [NSURL class], ^(NSURL *url, BOOL *stop) {
+     [index addURL:url];
+ });
+ @endcode
+ */
+
+/**
+ Executes a block for each object from the source that is a kind of the given class, in the order the source produces them.
+ */
+FOUNDATION_EXTERN void SafeCastEnumerateObjectsOfKind(__nonnull id<NSFastEnumeration> source, __nonnull Class cls, __nonnull void (^block)(__nonnull id obj, BOOL * __nonnull stop));
+
+/**
+ Executes a block for each object from the source that conforms to the given protocol, in the order the source produces them.
+ */
+FOUNDATION_EXTERN void SafeCastEnumerateObjectsConformingToProtocol(__nonnull id<NSFastEnumeration> source, Protocol * __nonnull protocol, __nonnull void (^block)(__nonnull id obj, BOOL * __nonnull stop));
+
+/**
+ Executes a block for each object from the source that responds to the given selector, in the order the source produces them.
+ */
+FOUNDATION_EXTERN void SafeCastEnumerateObjectsRespondingToSelector(__nonnull id<NSFastEnumeration> source, __nonnull SEL selector, __nonnull void (^block)(__nonnull id obj, BOOL * __nonnull stop));
+
+/**
+ Executes a block for each object from the source that matches the given filter, in the order the source produces them.
+ */
+FOUNDATION_EXTERN void SafeCastEnumerateObjectsMatchingFilter(__nonnull id<NSFastEnumeration> source, SafeCastFilter * __nonnull filter, __nonnull void (^block)(__nonnull id obj, BOOL * __nonnull stop));
+
+/**
+ @name For-in Loops
+ */
+
+/**
+ Returns an object that can be used in a for-in loop to visit only the objects from the source that are a kind of the given class.
+
+ The source is read in batches as the loop advances; nothing is copied. Objects an enumerator autoreleases are released by the caller's autorelease pool, so a long loop over an enumerator should drain a pool of its own periodically.
+ */
+FOUNDATION_EXTERN __nonnull id<NSFastEnumeration> SafeCastFastEnumerationOfKind(__nonnull id<NSFastEnumeration> source, __nonnull Class cls);
+
+/**
+ Returns an object that can be used in a for-in loop to visit only the objects from the source that conform to the given protocol.
+ */
+FOUNDATION_EXTERN __nonnull id<NSFastEnumeration> SafeCastFastEnumerationConformingToProtocol(__nonnull id<NSFastEnumeration> source, Protocol * __nonnull protocol);
+
+/**
+ Returns an object that can be used in a for-in loop to visit only the objects from the source that respond to the given selector.
+ */
+FOUNDATION_EXTERN __nonnull id<NSFastEnumeration> SafeCastFastEnumerationRespondingToSelector(__nonnull id<NSFastEnumeration> source, __nonnull SEL selector);
+
+/**
+ Returns an object that can be used in a for-in loop to visit only the objects from the source that match the given filter.
+ */
+FOUNDATION_EXTERN __nonnull id<NSFastEnumeration> SafeCastFastEnumerationMatchingFilter(__nonnull id<NSFastEnumeration> source, SafeCastFilter * __nonnull filter);
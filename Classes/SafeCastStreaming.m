@@ -0,0 +1,99 @@
+//
+//  SafeCastStreaming.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "SafeCastStreaming.h"
+#import "SafeCastDecisionCache.h"
+#import "SafeCastFastEnumeration.h"
+#import "SafeCastBatch.h"
+
+#define SAFE_CAST_STREAM_PRECONDITION if (block == nil) {[[[NSException alloc] initWithName:NSInvalidArgumentException \
+reason:[NSString stringWithFormat: @"Block passed to %s must not be nil", __func__]\
+userInfo:nil] raise];}
+
+// Each batch gets its own pool: objects a plain NSEnumerator autoreleases while filling a batch stay alive while the
+// batch is handled and are released before the next batch is read.
+#define SAFE_CAST_STREAM(test) {\
+NSFastEnumerationState state = {0};\
+__unsafe_unretained id batch[SAFE_CAST_BATCH_SIZE];\
+unsigned long mutations = 0;\
+BOOL started = NO;\
+BOOL stop = NO;\
+while (!stop) {\
+@autoreleasepool {\
+NSUInteger count = [source countByEnumeratingWithState:&state objects:batch count:SAFE_CAST_BATCH_SIZE];\
+if (count == 0) {break;}\
+if (!started) {mutations = *state.mutationsPtr; started = YES;}\
+for (NSUInteger i = 0; !stop && i < count; i++) {\
+if (*state.mutationsPtr != mutations) {objc_enumerationMutation(source);}\
+__unsafe_unretained id obj = state.itemsPtr[i];\
+if (test) {block(obj, &stop);}}}}}
+
+void SafeCastEnumerateObjectsOfKind(id<NSFastEnumeration> source, Class cls, void (^block)(id obj, BOOL *stop))
+{
+    SAFE_CAST_STREAM_PRECONDITION
+    SAFE_CAST_STREAM(SafeCastIsKindOfClass(obj, cls))
+}
+
+void SafeCastEnumerateObjectsConformingToProtocol(id<NSFastEnumeration> source, Protocol *protocol, void (^block)(id obj, BOOL *stop))
+{
+    SAFE_CAST_STREAM_PRECONDITION
+    SAFE_CAST_STREAM(SafeCastConformsToProtocol(obj, protocol))
+}
+
+void SafeCastEnumerateObjectsRespondingToSelector(id<NSFastEnumeration> source, SEL selector, void (^block)(id obj, BOOL *stop))
+{
+    SAFE_CAST_STREAM_PRECONDITION
+    SafeCastIMPMemo memo = {selector};
+    SAFE_CAST_STREAM(SafeCastIMPMemoLookup(&memo, obj) != NULL)
+}
+
+void SafeCastEnumerateObjectsMatchingFilter(id<NSFastEnumeration> source, SafeCastFilter *filter, void (^block)(id obj, BOOL *stop))
+{
+    SAFE_CAST_STREAM_PRECONDITION
+    SAFE_CAST_STREAM(SafeCastFilterMatchesObject(filter, obj))
+}
+
+id<NSFastEnumeration> SafeCastFastEnumerationOfKind(id<NSFastEnumeration> source, Class cls)
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:source kind:cls];
+}
+
+id<NSFastEnumeration> SafeCastFastEnumerationConformingToProtocol(id<NSFastEnumeration> source, Protocol *protocol)
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:source protocol:protocol];
+}
+
+id<NSFastEnumeration> SafeCastFastEnumerationRespondingToSelector(id<NSFastEnumeration> source, SEL selector)
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:source selector:selector];
+}
+
+id<NSFastEnumeration> SafeCastFastEnumerationMatchingFilter(id<NSFastEnumeration> source, SafeCastFilter *filter)
+{
+    return [[SafeCastFastEnumeration alloc] initWithSource:source filter:filter];
+}
@@ -0,0 +1,56 @@
+//
+//  SafeCastTypedArray.h
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ A mutable array that keeps its objects grouped by class, so that finding the objects of a kind or conforming to a protocol costs time in proportion to the number of matches instead of the size of the array.
+
+ For each class of object it holds, a typed array keeps the indexes of that class's instances in a bucket. The buckets are updated on every insertion, removal and replacement. Appending and removing the last object touch only one bucket; inserting or removing elsewhere shifts the indexes in every bucket, which costs time in proportion to the number of classes, not the number of objects.
+
+ A query by kind is answered from the buckets of the classes present that are the given class or inherit from it. Which classes those are is worked out once per queried class, from the class hierarchy, and remembered until an object of a new class is added. Protocol queries work the same way. Instances of classes that override -isKindOfClass: or -conformsToProtocol: are asked directly.
+
+ The following methods use the buckets; every other SafeCast method works as it does on any array:
+
+ - safe_enumerateObjectsOfKind:usingBlock: and safe_enumerateObjectsConformingToProtocol:usingBlock:
+ - safe_indexesOfObjectsOfKind: and safe_indexesOfObjectsConformingToProtocol:
+ - safe_objectsOfKind: and safe_objectsConformingToProtocol:
+ - safe_countOfObjectsOfKind: and safe_countOfObjectsConformingToProtocol:
+
+ Like NSMutableArray, a typed array is not thread-safe. Queries update its caches, so even concurrent reads must be synchronized.
+
+ @code
+ SafeCastTypedArray *nodes = [SafeCastTypedArray array];
+ [nodes addObjectsFromArray:sceneNodes];
+ [nodes safe_enumerateObjectsOfKind:[SpriteNode class] usingBlock:^(SpriteNode *node, NSUInteger idx, BOOL *stop) {
+     [node update];
+ }];
+ @endcode
+ */
+@interface SafeCastTypedArray : NSMutableArray
+
+@end
@@ -0,0 +1,367 @@
+//
+//  SafeCastTypedArray.m
+//  Pods
+//
+//  Created by agent on 10/18/26.
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2026 agent
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "SafeCastTypedArray.h"
+#import "SafeCastCollections.h"
+#import "SafeCastDecisionCache.h"
+#import "SafeCastBatch.h"
+
+static BOOL SafeCastClassInheritsFromClass(Class cls, Class target)
+{
+    for (; cls != Nil; cls = class_getSuperclass(cls)) {
+        if (cls == target) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+static BOOL SafeCastClassConformsToProtocol(Class cls, Protocol *protocol)
+{
+    for (; cls != Nil; cls = class_getSuperclass(cls)) {
+        if (class_conformsToProtocol(cls, protocol)) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+/*
+ The buckets that answer a query by kind or protocol: those whose class matches, and those whose class overrides the method being answered, so that each of their instances has to be asked.
+ */
+@interface SafeCastTypedArrayQuery : NSObject {
+    @package
+    __unsafe_unretained Class _kind;
+    __unsafe_unretained Protocol *_protocol;
+    NSMutableArray *_matchingBuckets;
+    NSMutableArray *_askingBuckets;
+}
+@end
+
+@implementation SafeCastTypedArrayQuery
+
+- (instancetype)initWithBuckets:(NSMapTable *)buckets kind:(Class)kind protocol:(Protocol *)protocol
+{
+    self = [super init];
+    if (self) {
+        _kind = kind;
+        _protocol = protocol;
+        _matchingBuckets = [NSMutableArray array];
+        _askingBuckets = [NSMutableArray array];
+        SEL selector = kind ? @selector(isKindOfClass:) : @selector(conformsToProtocol:);
+        for (Class cls in buckets) {
+            NSMutableIndexSet *bucket = [buckets objectForKey:cls];
+            if (!SafeCastClassUsesRootImplementation(cls, selector)) {
+                [_askingBuckets addObject:bucket];
+            } else if (kind ? SafeCastClassInheritsFromClass(cls, kind) : SafeCastClassConformsToProtocol(cls, protocol)) {
+                [_matchingBuckets addObject:bucket];
+            }
+        }
+    }
+    return self;
+}
+
+- (BOOL)objectMatches:(id)obj
+{
+    return _kind ? [obj isKindOfClass:_kind] : [obj conformsToProtocol:_protocol];
+}
+
+@end
+
+@implementation SafeCastTypedArray {
+    NSMutableArray *_objects;
+    // The bucket each object was filed in when it was inserted, by index. An object's class can change afterwards
+    // (key-value observing swaps in a subclass, and object_setClass can install anything), so looking its bucket up
+    // again by its current class at removal could miss and leave a stale index behind.
+    NSMutableArray *_objectBuckets;
+    NSMapTable *_buckets;
+    NSMapTable *_kindQueries;
+    NSMapTable *_protocolQueries;
+}
+
+static NSMapTable *SafeCastTypedArrayPointerKeyedTable(void)
+{
+    return [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                     valueOptions:NSPointerFunctionsStrongMemory
+                                         capacity:0];
+}
+
+- (instancetype)init
+{
+    return [self initWithCapacity:0];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)numItems
+{
+    self = [super init];
+    if (self) {
+        _objects = [[NSMutableArray alloc] initWithCapacity:numItems];
+        _objectBuckets = [[NSMutableArray alloc] initWithCapacity:numItems];
+        _buckets = SafeCastTypedArrayPointerKeyedTable();
+        _kindQueries = SafeCastTypedArrayPointerKeyedTable();
+        _protocolQueries = SafeCastTypedArrayPointerKeyedTable();
+    }
+    return self;
+}
+
+- (instancetype)initWithObjects:(const id [])objects count:(NSUInteger)cnt
+{
+    self = [self initWithCapacity:cnt];
+    if (self) {
+        for (NSUInteger i = 0; i < cnt; i++) {
+            [self addObject:objects[i]];
+        }
+    }
+    return self;
+}
+
+#pragma mark - Primitive Methods
+
+- (NSUInteger)count
+{
+    return _objects.count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    return [_objects objectAtIndex:index];
+}
+
+- (void)getObjects:(id __unsafe_unretained [])objects range:(NSRange)range
+{
+    [_objects getObjects:objects range:range];
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+    return [_objects countByEnumeratingWithState:state objects:buffer count:len];
+}
+
+- (void)insertObject:(id)anObject atIndex:(NSUInteger)index
+{
+    NSMutableIndexSet *bucket = [self bucketForClass:object_getClass(anObject)];
+    [_objects insertObject:anObject atIndex:index];
+    [_objectBuckets insertObject:bucket atIndex:index];
+    if (index + 1 < _objects.count) {
+        [self shiftIndexesStartingAtIndex:index by:1];
+    }
+    [bucket addIndex:index];
+}
+
+- (void)removeObjectAtIndex:(NSUInteger)index
+{
+    [[_objectBuckets objectAtIndex:index] removeIndex:index];
+    [_objects removeObjectAtIndex:index];
+    [_objectBuckets removeObjectAtIndex:index];
+    if (index < _objects.count) {
+        [self shiftIndexesStartingAtIndex:index + 1 by:-1];
+    }
+}
+
+- (void)addObject:(id)anObject
+{
+    [self insertObject:anObject atIndex:_objects.count];
+}
+
+- (void)removeLastObject
+{
+    if (_objects.count > 0) {
+        [self removeObjectAtIndex:_objects.count - 1];
+    }
+}
+
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)anObject
+{
+    NSMutableIndexSet *oldBucket = [_objectBuckets objectAtIndex:index];
+    NSMutableIndexSet *newBucket = [self bucketForClass:object_getClass(anObject)];
+    [_objects replaceObjectAtIndex:index withObject:anObject];
+    if (oldBucket != newBucket) {
+        [oldBucket removeIndex:index];
+        [newBucket addIndex:index];
+        [_objectBuckets replaceObjectAtIndex:index withObject:newBucket];
+    }
+}
+
+- (void)removeAllObjects
+{
+    [_objects removeAllObjects];
+    [_objectBuckets removeAllObjects];
+    for (NSMutableIndexSet *bucket in [_buckets objectEnumerator]) {
+        [bucket removeAllIndexes];
+    }
+}
+
+- (id)mutableCopyWithZone:(NSZone *)zone
+{
+    SafeCastTypedArray *copy = [[SafeCastTypedArray allocWithZone:zone] initWithCapacity:_objects.count];
+    [copy addObjectsFromArray:_objects];
+    return copy;
+}
+
+#pragma mark - Buckets
+
+// Buckets are kept when they empty out, so the cached queries stay valid until an object of a new class arrives.
+- (NSMutableIndexSet *)bucketForClass:(Class)cls
+{
+    NSMutableIndexSet *bucket = [_buckets objectForKey:cls];
+    if (bucket == nil) {
+        bucket = [NSMutableIndexSet indexSet];
+        [_buckets setObject:bucket forKey:cls];
+        [_kindQueries removeAllObjects];
+        [_protocolQueries removeAllObjects];
+    }
+    return bucket;
+}
+
+- (void)shiftIndexesStartingAtIndex:(NSUInteger)index by:(NSInteger)delta
+{
+    for (NSMutableIndexSet *bucket in [_buckets objectEnumerator]) {
+        [bucket shiftIndexesStartingAtIndex:index by:delta];
+    }
+}
+
+- (SafeCastTypedArrayQuery *)queryForKind:(Class)class
+{
+    SafeCastTypedArrayQuery *query = [_kindQueries objectForKey:class];
+    if (query == nil) {
+        query = [[SafeCastTypedArrayQuery alloc] initWithBuckets:_buckets kind:class protocol:nil];
+        [_kindQueries setObject:query forKey:class];
+    }
+    return query;
+}
+
+- (SafeCastTypedArrayQuery *)queryForProtocol:(Protocol *)protocol
+{
+    SafeCastTypedArrayQuery *query = [_protocolQueries objectForKey:protocol];
+    if (query == nil) {
+        query = [[SafeCastTypedArrayQuery alloc] initWithBuckets:_buckets kind:Nil protocol:protocol];
+        [_protocolQueries setObject:query forKey:protocol];
+    }
+    return query;
+}
+
+- (NSIndexSet *)indexesMatchingQuery:(SafeCastTypedArrayQuery *)query
+{
+    if (query->_askingBuckets.count == 0) {
+        if (query->_matchingBuckets.count == 0) {
+            return [NSIndexSet indexSet];
+        }
+        if (query->_matchingBuckets.count == 1) {
+            return [query->_matchingBuckets[0] copy];
+        }
+    }
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    for (NSIndexSet *bucket in query->_matchingBuckets) {
+        [indexes addIndexes:bucket];
+    }
+    for (NSIndexSet *bucket in query->_askingBuckets) {
+        [bucket enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            if ([query objectMatches:[_objects objectAtIndex:idx]]) {
+                [indexes addIndex:idx];
+            }
+        }];
+    }
+    return [indexes copy];
+}
+
+- (NSUInteger)countOfObjectsMatchingQuery:(SafeCastTypedArrayQuery *)query
+{
+    NSUInteger count = 0;
+    for (NSIndexSet *bucket in query->_matchingBuckets) {
+        count += bucket.count;
+    }
+    for (NSIndexSet *bucket in query->_askingBuckets) {
+        count += [bucket countOfIndexesPassingTest:^BOOL(NSUInteger idx, BOOL *stop) {
+            return [query objectMatches:[_objects objectAtIndex:idx]];
+        }];
+    }
+    return count;
+}
+
+- (void)enumerateObjectsMatchingQuery:(SafeCastTypedArrayQuery *)query caller:(SEL)caller usingBlock:(void (^)(id obj, NSUInteger idx, BOOL *stop))block
+{
+    if (block == nil) {
+        [[[NSException alloc] initWithName:NSInvalidArgumentException
+                                    reason:[NSString stringWithFormat: @"Block passed to %@ must not be nil", NSStringFromSelector(caller)]
+                                  userInfo:nil] raise];
+    }
+    NSMutableArray *objects = _objects;
+    [[self indexesMatchingQuery:query] enumerateRangesUsingBlock:^(NSRange range, BOOL *stopRanges) {
+        BOOL stop = NO;
+        SAFE_CAST_RANGE_BEGIN(objects, range, NO, obj)
+        block(obj, SAFE_CAST_RANGE_INDEX, &stop);
+        if (stop) SAFE_CAST_RANGE_BREAK
+        SAFE_CAST_RANGE_END
+        *stopRanges = stop;
+    }];
+}
+
+#pragma mark - Kind of Class
+
+- (void)safe_enumerateObjectsOfKind:(Class)class usingBlock:(void (^)(id obj, NSUInteger idx, BOOL *stop))block
+{
+    [self enumerateObjectsMatchingQuery:[self queryForKind:class] caller:_cmd usingBlock:block];
+}
+
+- (NSIndexSet *)safe_indexesOfObjectsOfKind:(Class)class
+{
+    return [self indexesMatchingQuery:[self queryForKind:class]];
+}
+
+- (NSArray *)safe_objectsOfKind:(Class)class
+{
+    return [_objects objectsAtIndexes:[self indexesMatchingQuery:[self queryForKind:class]]];
+}
+
+- (NSUInteger)safe_countOfObjectsOfKind:(Class)class
+{
+    return [self countOfObjectsMatchingQuery:[self queryForKind:class]];
+}
+
+#pragma mark - Protocols
+
+- (void)safe_enumerateObjectsConformingToProtocol:(Protocol *)protocol usingBlock:(void (^)(id obj, NSUInteger idx, BOOL *stop))block
+{
+    [self enumerateObjectsMatchingQuery:[self queryForProtocol:protocol] caller:_cmd usingBlock:block];
+}
+
+- (NSIndexSet *)safe_indexesOfObjectsConformingToProtocol:(Protocol *)protocol
+{
+    return [self indexesMatchingQuery:[self queryForProtocol:protocol]];
+}
+
+- (NSArray *)safe_objectsConformingToProtocol:(Protocol *)protocol
+{
+    return [_objects objectsAtIndexes:[self indexesMatchingQuery:[self queryForProtocol:protocol]]];
+}
+
+- (NSUInteger)safe_countOfObjectsConformingToProtocol:(Protocol *)protocol
+{
+    return [self countOfObjectsMatchingQuery:[self queryForProtocol:protocol]];
+}
+
+@end
@@ -0,0 +1,633 @@
+//
+//  SafeCastBenchmark.m
+//  SafeCast
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+//  Compares each safe_ method against the loop it replaces, reporting
+//  nanoseconds per element and Objective-C allocations per call across
+//  collection sizes and homogeneity ratios.
+//
+//  Usage: safecast-benchmark [max-count]
+//
+
+#import <Foundation/Foundation.h>
+#import <time.h>
+#import "SafeCast.h"
+
+static const NSUInteger SCBSizes[] = {10, 1000, 100000, 10000000};
+static const double SCBRatios[] = {1.0, 0.5, 0.1};
+
+// Each measurement repeats its body until roughly this many elements have
+// been visited, so small collections are not dominated by timer resolution.
+static const NSUInteger SCBElementsPerMeasurement = 10000000;
+
+#pragma mark - Model Classes
+
+@protocol SCBProtocol <NSObject>
+- (void)touch;
+@end
+
+@interface SCBModel : NSObject <SCBProtocol>
+@property (nonatomic, assign) NSUInteger value;
+@end
+
+@implementation SCBModel
+- (void)touch { self.value++; }
+@end
+
+@interface SCBOther : NSObject
+@end
+
+@implementation SCBOther
+@end
+
+#pragma mark - Fixtures
+
+@interface SCBFixture : NSObject
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) double ratio;
+@property (nonatomic, readonly) NSArray *array;
+@property (nonatomic, readonly) NSOrderedSet *orderedSet;
+@property (nonatomic, readonly) NSSet *set;
+@property (nonatomic, readonly) NSDictionary *dictionary;
+- (instancetype)initWithCount:(NSUInteger)count ratio:(double)ratio;
+@end
+
+@implementation SCBFixture
+
+- (instancetype)initWithCount:(NSUInteger)count ratio:(double)ratio
+{
+    self = [super init];
+    if (self == nil) {
+        return nil;
+    }
+    _count = count;
+    _ratio = ratio;
+
+    // Matching objects are spread evenly rather than clustered, so branch
+    // prediction sees the same mix a real heterogeneous collection would.
+    NSUInteger matchesPerTen = (NSUInteger)(ratio * 10 + 0.5);
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [objects addObject:(i % 10 < matchesPerTen) ? [SCBModel new] : [SCBOther new]];
+        [keys addObject:@(i)];
+    }
+    _array = [objects copy];
+    _orderedSet = [NSOrderedSet orderedSetWithArray:objects];
+    _set = [NSSet setWithArray:objects];
+    _dictionary = [NSDictionary dictionaryWithObjects:objects forKeys:keys];
+    return self;
+}
+
+@end
+
+#pragma mark - Cases
+
+typedef void (^SCBBody)(SCBFixture *fixture);
+
+@interface SCBCase : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) SCBBody baseline;
+@property (nonatomic, copy) SCBBody safe;
+@end
+
+@implementation SCBCase
+@end
+
+static SCBCase *SCBMakeCase(NSString *name, SCBBody baseline, SCBBody safe)
+{
+    SCBCase *c = [SCBCase new];
+    c.name = name;
+    c.baseline = baseline;
+    c.safe = safe;
+    return c;
+}
+
+static void SCBTouchFunction(__unsafe_unretained id obj, NSUInteger idx, BOOL *stop, void *context)
+{
+    [obj touch];
+}
+
+static NSArray *SCBAllCases(void)
+{
+    Class kind = [SCBModel class];
+    Protocol *protocol = @protocol(SCBProtocol);
+    SEL selector = @selector(touch);
+    SafeCastFilter *filter = [SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:kind],
+                                                                   [SafeCastFilter filterConformingToProtocol:protocol]]];
+    NSArray *kinds = @[kind, [SCBOther class]];
+
+    return @[
+        SCBMakeCase(@"+safe_cast:",
+                    ^(SCBFixture *f) {
+                        for (id obj in f.array) {
+                            SCBModel *model = [obj isKindOfClass:kind] ? obj : nil;
+                            [model touch];
+                        }
+                    },
+                    ^(SCBFixture *f) {
+                        for (id obj in f.array) {
+                            [[SCBModel safe_cast:obj] touch];
+                        }
+                    }),
+        SCBMakeCase(@"NSArray -safe_makeObjectsSafelyPerformSelector:",
+                    ^(SCBFixture *f) {
+                        for (id obj in f.array) {
+                            if ([obj respondsToSelector:selector]) {
+                                [obj touch];
+                            }
+                        }
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_makeObjectsSafelyPerformSelector:selector];
+                    }),
+        SCBMakeCase(@"NSSet -safe_makeObjectsSafelyPerformSelector:withObject:",
+                    ^(SCBFixture *f) {
+                        for (id obj in f.set) {
+                            if ([obj respondsToSelector:@selector(isEqual:)]) {
+                                [obj isEqual:f];
+                            }
+                        }
+                    },
+                    ^(SCBFixture *f) {
+                        [f.set safe_makeObjectsSafelyPerformSelector:@selector(isEqual:) withObject:f];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsOfKind:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.array enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsOfKind:kind usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsConformingToProtocol:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.array enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj conformsToProtocol:protocol]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsConformingToProtocol:protocol usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsRespondingToSelector:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.array enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj respondsToSelector:selector]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsRespondingToSelector:selector usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsOfKind:atIndexes:options:usingBlock:",
+                    ^(SCBFixture *f) {
+                        NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, f.count / 2)];
+                        [f.array enumerateObjectsAtIndexes:indexes options:0 usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, f.count / 2)];
+                        [f.array safe_enumerateObjectsOfKind:kind atIndexes:indexes options:0 usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsOfKind:withOptions:NSEnumerationConcurrent",
+                    ^(SCBFixture *f) {
+                        [f.array enumerateObjectsWithOptions:NSEnumerationConcurrent usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsOfKind:kind withOptions:NSEnumerationConcurrent usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsOfKind:concurrentlyWithGrainSize:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.array enumerateObjectsWithOptions:NSEnumerationConcurrent usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsOfKind:kind concurrentlyWithGrainSize:0 usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_indexesOfObjectsOfKind:",
+                    ^(SCBFixture *f) {
+                        [f.array indexesOfObjectsPassingTest:^BOOL(id obj, NSUInteger idx, BOOL *stop) {
+                            return [obj isKindOfClass:kind];
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_indexesOfObjectsOfKind:kind];
+                    }),
+        SCBMakeCase(@"NSArray -safe_objectsOfKind:",
+                    ^(SCBFixture *f) {
+                        NSMutableArray *result = [NSMutableArray array];
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                [result addObject:obj];
+                            }
+                        }
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_objectsOfKind:kind];
+                    }),
+        SCBMakeCase(@"NSArray -safe_fastEnumerationOfKind:",
+                    ^(SCBFixture *f) {
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }
+                    },
+                    ^(SCBFixture *f) {
+                        for (SCBModel *obj in [f.array safe_fastEnumerationOfKind:kind]) {
+                            [obj touch];
+                        }
+                    }),
+        SCBMakeCase(@"NSOrderedSet -safe_enumerateObjectsOfKind:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.orderedSet enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.orderedSet safe_enumerateObjectsOfKind:kind usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSOrderedSet -safe_objectsConformingToProtocol:",
+                    ^(SCBFixture *f) {
+                        NSMutableOrderedSet *result = [NSMutableOrderedSet orderedSet];
+                        for (id obj in f.orderedSet) {
+                            if ([obj conformsToProtocol:protocol]) {
+                                [result addObject:obj];
+                            }
+                        }
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.orderedSet safe_objectsConformingToProtocol:protocol];
+                    }),
+        SCBMakeCase(@"NSSet -safe_enumerateObjectsOfKind:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.set enumerateObjectsUsingBlock:^(id obj, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.set safe_enumerateObjectsOfKind:kind usingBlock:^(id obj, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSSet -safe_objectsRespondingToSelector:",
+                    ^(SCBFixture *f) {
+                        NSMutableSet *result = [NSMutableSet set];
+                        for (id obj in f.set) {
+                            if ([obj respondsToSelector:selector]) {
+                                [result addObject:obj];
+                            }
+                        }
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.set safe_objectsRespondingToSelector:selector];
+                    }),
+        SCBMakeCase(@"NSDictionary -safe_enumerateKeysAndObjectsOfKind:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.dictionary safe_enumerateKeysAndObjectsOfKind:kind usingBlock:^(id key, id obj, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSDictionary -safe_enumerateKeysAndObjectsRespondingToSelector:withOptions:NSEnumerationConcurrent",
+                    ^(SCBFixture *f) {
+                        [f.dictionary enumerateKeysAndObjectsWithOptions:NSEnumerationConcurrent usingBlock:^(id key, id obj, BOOL *stop) {
+                            if ([obj respondsToSelector:selector]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.dictionary safe_enumerateKeysAndObjectsRespondingToSelector:selector withOptions:NSEnumerationConcurrent usingBlock:^(id key, id obj, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSDictionary -safe_keysAndObjectsOfKind:",
+                    ^(SCBFixture *f) {
+                        NSMutableDictionary *result = [NSMutableDictionary dictionary];
+                        [f.dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+                            if ([obj isKindOfClass:kind]) {
+                                result[key] = obj;
+                            }
+                        }];
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.dictionary safe_keysAndObjectsOfKind:kind];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsOfKind:function:context:",
+                    ^(SCBFixture *f) {
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                SCBTouchFunction(obj, 0, NULL, NULL);
+                            }
+                        }
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsOfKind:kind function:SCBTouchFunction context:NULL];
+                    }),
+        SCBMakeCase(@"NSArray -safe_enumerateObjectsMatchingFilter:usingBlock:",
+                    ^(SCBFixture *f) {
+                        [f.array enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            if ([obj isKindOfClass:kind] && [obj conformsToProtocol:protocol]) {
+                                [obj touch];
+                            }
+                        }];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_enumerateObjectsMatchingFilter:filter usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                            [obj touch];
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_countOfObjectsOfKind:",
+                    ^(SCBFixture *f) {
+                        NSUInteger count = 0;
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                count++;
+                            }
+                        }
+                        (void)count;
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_countOfObjectsOfKind:kind];
+                    }),
+        SCBMakeCase(@"NSArray -safe_lastObjectRespondingToSelector:",
+                    ^(SCBFixture *f) {
+                        for (id obj in [f.array reverseObjectEnumerator]) {
+                            if ([obj respondsToSelector:selector]) {
+                                break;
+                            }
+                        }
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_lastObjectRespondingToSelector:selector];
+                    }),
+        SCBMakeCase(@"NSArray -safe_partitionObjectsByKinds:",
+                    ^(SCBFixture *f) {
+                        NSMutableArray *models = [NSMutableArray array];
+                        NSMutableArray *others = [NSMutableArray array];
+                        NSMutableArray *unmatched = [NSMutableArray array];
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                [models addObject:obj];
+                            } else if ([obj isKindOfClass:[SCBOther class]]) {
+                                [others addObject:obj];
+                            } else {
+                                [unmatched addObject:obj];
+                            }
+                        }
+                        (void)@[[models copy], [others copy], [unmatched copy]];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_partitionObjectsByKinds:kinds];
+                    }),
+        SCBMakeCase(@"NSArray -safe_reduceObjectsOfKind:initial:combine:merge:",
+                    ^(SCBFixture *f) {
+                        NSUInteger sum = 0;
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                sum += [(SCBModel *)obj value];
+                            }
+                        }
+                        (void)@(sum);
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_reduceObjectsOfKind:kind initial:@0 combine:^id(NSNumber *sum, SCBModel *model) {
+                            return @(sum.unsignedIntegerValue + model.value);
+                        } merge:nil];
+                    }),
+        SCBMakeCase(@"NSArray -safe_reduceObjectsOfKind:concurrentlyWithGrainSize:initial:combine:merge:",
+                    ^(SCBFixture *f) {
+                        NSUInteger sum = 0;
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                sum += [(SCBModel *)obj value];
+                            }
+                        }
+                        (void)@(sum);
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_reduceObjectsOfKind:kind concurrentlyWithGrainSize:0 initial:@0 combine:^id(NSNumber *sum, SCBModel *model) {
+                            return @(sum.unsignedIntegerValue + model.value);
+                        } merge:^id(NSNumber *left, NSNumber *right) {
+                            return @(left.unsignedIntegerValue + right.unsignedIntegerValue);
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_compactMapObjectsOfKind:usingBlock:",
+                    ^(SCBFixture *f) {
+                        NSMutableArray *result = [NSMutableArray array];
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                [result addObject:@([(SCBModel *)obj value])];
+                            }
+                        }
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_compactMapObjectsOfKind:kind usingBlock:^id(SCBModel *model) {
+                            return @(model.value);
+                        }];
+                    }),
+        SCBMakeCase(@"NSArray -safe_mapObjectsPerformingSelector:",
+                    ^(SCBFixture *f) {
+                        NSMutableArray *result = [NSMutableArray array];
+                        for (id obj in f.array) {
+                            if ([obj respondsToSelector:@selector(description)]) {
+                                [result addObject:[obj description]];
+                            }
+                        }
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [f.array safe_mapObjectsPerformingSelector:@selector(description)];
+                    }),
+        SCBMakeCase(@"NSMutableArray -safe_removeObjectsNotOfKind:",
+                    ^(SCBFixture *f) {
+                        NSMutableArray *array = [f.array mutableCopy];
+                        NSIndexSet *discards = [array indexesOfObjectsPassingTest:^BOOL(id obj, NSUInteger idx, BOOL *stop) {
+                            return ![obj isKindOfClass:kind];
+                        }];
+                        [array removeObjectsAtIndexes:discards];
+                    },
+                    ^(SCBFixture *f) {
+                        NSMutableArray *array = [f.array mutableCopy];
+                        [array safe_removeObjectsNotOfKind:kind];
+                    }),
+        SCBMakeCase(@"NSMutableDictionary -safe_removeObjectsNotOfKind:",
+                    ^(SCBFixture *f) {
+                        NSMutableDictionary *dictionary = [f.dictionary mutableCopy];
+                        NSSet *discards = [dictionary keysOfEntriesPassingTest:^BOOL(id key, id obj, BOOL *stop) {
+                            return ![obj isKindOfClass:kind];
+                        }];
+                        [dictionary removeObjectsForKeys:[discards allObjects]];
+                    },
+                    ^(SCBFixture *f) {
+                        NSMutableDictionary *dictionary = [f.dictionary mutableCopy];
+                        [dictionary safe_removeObjectsNotOfKind:kind];
+                    }),
+        SCBMakeCase(@"NSArray -safe_lazyArrayOfKind:",
+                    ^(SCBFixture *f) {
+                        NSUInteger count = 0;
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind]) {
+                                [obj touch];
+                                count++;
+                            }
+                        }
+                        (void)count;
+                    },
+                    ^(SCBFixture *f) {
+                        for (SCBModel *model in [f.array safe_lazyArrayOfKind:kind]) {
+                            [model touch];
+                        }
+                    }),
+        SCBMakeCase(@"SafeCastSequence -ofKind: -respondingTo: -toArray",
+                    ^(SCBFixture *f) {
+                        NSMutableArray *result = [NSMutableArray array];
+                        for (id obj in f.array) {
+                            if ([obj isKindOfClass:kind] && [obj respondsToSelector:selector]) {
+                                [result addObject:obj];
+                            }
+                        }
+                        [result copy];
+                    },
+                    ^(SCBFixture *f) {
+                        [[[[f.array safe_sequence] ofKind:kind] respondingTo:selector] toArray];
+                    }),
+    ];
+}
+
+#pragma mark - Measurement
+
+typedef struct {
+    double nanosecondsPerElement;
+    double allocationsPerCall;
+} SCBResult;
+
+static uint64_t SCBNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static unsigned long long SCBTotalAllocations(void)
+{
+    unsigned long long total = 0;
+    const Class *classes = GSDebugAllocationClassList();
+    for (NSUInteger i = 0; classes != NULL && classes[i] != Nil; i++) {
+        total += GSDebugAllocationTotal(classes[i]);
+    }
+    return total;
+}
+
+static SCBResult SCBMeasure(SCBFixture *fixture, SCBBody body)
+{
+    NSUInteger repetitions = MAX(1, SCBElementsPerMeasurement / MAX(1, fixture.count));
+    SCBResult result;
+
+    @autoreleasepool {
+        body(fixture); // Warm caches and the runtime's method lookup.
+    }
+
+    uint64_t start = SCBNow();
+    for (NSUInteger i = 0; i < repetitions; i++) {
+        @autoreleasepool {
+            body(fixture);
+        }
+    }
+    uint64_t elapsed = SCBNow() - start;
+    result.nanosecondsPerElement = (double)elapsed / ((double)repetitions * MAX(1, fixture.count));
+
+    // Allocation tracking slows every alloc down, so it gets its own run.
+    GSDebugAllocationActive(YES);
+    unsigned long long before = SCBTotalAllocations();
+    @autoreleasepool {
+        body(fixture);
+    }
+    result.allocationsPerCall = (double)(SCBTotalAllocations() - before);
+    GSDebugAllocationActive(NO);
+
+    return result;
+}
+
+#pragma mark - Main
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool {
+        NSUInteger maxCount = argc > 1 ? (NSUInteger)strtoull(argv[1], NULL, 10) : NSUIntegerMax;
+        NSArray *cases = SCBAllCases();
+
+        printf("%-10s %-6s %-100s %14s %14s %12s %12s\n",
+               "count", "ratio", "method", "loop ns/elt", "safe ns/elt", "loop allocs", "safe allocs");
+
+        for (size_t s = 0; s < sizeof(SCBSizes) / sizeof(SCBSizes[0]); s++) {
+            if (SCBSizes[s] > maxCount) {
+                break;
+            }
+            for (size_t r = 0; r < sizeof(SCBRatios) / sizeof(SCBRatios[0]); r++) {
+                @autoreleasepool {
+                    SCBFixture *fixture = [[SCBFixture alloc] initWithCount:SCBSizes[s] ratio:SCBRatios[r]];
+                    for (SCBCase *c in cases) {
+                        SCBResult baseline = SCBMeasure(fixture, c.baseline);
+                        SCBResult safe = SCBMeasure(fixture, c.safe);
+                        printf("%-10lu %-6.2f %-100s %14.2f %14.2f %12.0f %12.0f\n",
+                               (unsigned long)fixture.count, fixture.ratio, c.name.UTF8String,
+                               baseline.nanosecondsPerElement, safe.nanosecondsPerElement,
+                               baseline.allocationsPerCall, safe.allocationsPerCall);
+                        fflush(stdout);
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
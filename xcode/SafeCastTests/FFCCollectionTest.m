@@ -33,6 +33,104 @@
 @implementation FFCProtocolTestObject
 @end
 
+@interface FFCOverridingTestObject : FFCTestObject
+@end
+@implementation FFCOverridingTestObject
+- (void)method { self.number = @1; }
+@end
+
+@interface FFCImpostorArray : NSObject
+@end
+@implementation FFCImpostorArray
+- (BOOL)isKindOfClass:(Class)aClass { return aClass == [NSMutableArray class] || [super isKindOfClass:aClass]; }
+@end
+
+@interface FFCSelectiveTestObject : NSObject
+@property (nonatomic, assign) BOOL respondsToMethod;
+@property (nonatomic, assign) BOOL methodCalled;
+@end
+@implementation FFCSelectiveTestObject
+- (void)method { self.methodCalled = YES; }
+- (BOOL)respondsToSelector:(SEL)aSelector
+{
+    if (aSelector == @selector(method)) {
+        return self.respondsToMethod;
+    }
+    return [super respondsToSelector:aSelector];
+}
+@end
+
+@interface FFCDynamicProtocolTestObject : FFCTestObject
+@property (nonatomic, assign) BOOL claimsConformance;
+@end
+@implementation FFCDynamicProtocolTestObject
+- (BOOL)conformsToProtocol:(Protocol *)aProtocol
+{
+    return self.claimsConformance || [super conformsToProtocol:aProtocol];
+}
+@end
+
+static NSUInteger FFCLiveGeneratedObjects = 0;
+
+@interface FFCGeneratedTestObject : FFCTestObject
+@end
+@implementation FFCGeneratedTestObject
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        FFCLiveGeneratedObjects++;
+    }
+    return self;
+}
+- (void)dealloc { FFCLiveGeneratedObjects--; }
+@end
+
+// A dictionary that creates its values on demand, so nothing but the caller keeps them alive.
+@interface FFCGeneratingDictionary : NSDictionary
+@end
+@implementation FFCGeneratingDictionary
+- (NSUInteger)count { return 3; }
+- (id)objectForKey:(id)key
+{
+    FFCGeneratedTestObject *obj = [FFCGeneratedTestObject new];
+    obj.number = key;
+    return obj;
+}
+- (NSEnumerator *)keyEnumerator { return [@[@1, @2, @3] objectEnumerator]; }
+@end
+
+#pragma mark - Test Functions
+
+static void FFCSetNumberAtIndex(__unsafe_unretained id obj, NSUInteger idx, BOOL *stop, void *context)
+{
+    [obj setNumber:@(idx)];
+    (*(NSUInteger *)context)++;
+}
+
+static void FFCSetNumberAndStop(__unsafe_unretained id obj, NSUInteger idx, BOOL *stop, void *context)
+{
+    [obj setNumber:@3];
+    *stop = YES;
+}
+
+static void FFCCollectObject(__unsafe_unretained id obj, BOOL *stop, void *context)
+{
+    [(__bridge NSMutableSet *)context addObject:obj];
+}
+
+static void FFCCollectKey(__unsafe_unretained id key, __unsafe_unretained id obj, BOOL *stop, void *context)
+{
+    [(__bridge NSMutableSet *)context addObject:key];
+}
+
+static void FFCCountLiveObject(__unsafe_unretained id key, __unsafe_unretained id obj, BOOL *stop, void *context)
+{
+    if (FFCLiveGeneratedObjects > 0 && [[obj number] isEqual:key]) {
+        (*(NSUInteger *)context)++;
+    }
+}
+
 @interface FFCArrayTest : XCTestCase
 @end
 
@@ -45,6 +143,18 @@
 @interface FFCDictionaryTest : XCTestCase
 @end
 
+@interface FFCTypedArrayTest : XCTestCase
+@end
+
+@interface FFCPointerCollectionTest : XCTestCase
+@end
+
+@interface FFCStreamingTest : XCTestCase
+@end
+
+@interface FFCSequenceTest : XCTestCase
+@end
+
 #pragma mark - NSArray Tests
 
 @implementation FFCArrayTest
@@ -81,6 +191,31 @@
     XCTAssertEqualObjects([FFCTestObject safe_cast:a[3]].number, @3, @"known objects should have had methods called on it with correct object");
 }
 
+- (void)testMakeObjectSafelyPerformSelectorUsesEachClassImplementation
+{
+    NSArray *a = @[[FFCTestObject new], [FFCOverridingTestObject new], [NSObject new], [FFCTestObject new], [FFCOverridingTestObject new]];
+    
+    [a safe_makeObjectsSafelyPerformSelector:@selector(method)];
+    
+    XCTAssertTrue([FFCTestObject safe_cast:a[0]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:a[1]].number, @1, @"subclasses should have their own implementation called");
+    XCTAssertTrue([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:a[4]].number, @1, @"subclasses should have their own implementation called");
+}
+
+- (void)testMakeObjectSafelyPerformSelectorAsksObjectsThatOverrideRespondsToSelector
+{
+    FFCSelectiveTestObject *responding = [FFCSelectiveTestObject new];
+    responding.respondsToMethod = YES;
+    NSArray *a = @[[FFCSelectiveTestObject new], responding, [FFCSelectiveTestObject new]];
+    
+    [a safe_makeObjectsSafelyPerformSelector:@selector(method)];
+    
+    XCTAssertFalse([a[0] methodCalled], @"objects claiming not to respond should not have had methods called on them");
+    XCTAssertTrue([a[1] methodCalled], @"objects claiming to respond should have had methods called on them");
+    XCTAssertFalse([a[2] methodCalled], @"objects claiming not to respond should not have had methods called on them");
+}
+
 - (void)testRespondsToSelector
 {
     NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
@@ -262,229 +397,1180 @@
     XCTAssertEqualObjects(indexSet, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)], @"should return an index set corresponding to the objects of kind");
 }
 
-@end
+- (void)testEnumerateObjectsConformingToProtocolAsksObjectsThatOverrideConformance
+{
+    FFCDynamicProtocolTestObject *claiming = [FFCDynamicProtocolTestObject new];
+    claiming.claimsConformance = YES;
+    NSArray *a = @[[FFCDynamicProtocolTestObject new], claiming, [FFCDynamicProtocolTestObject new]];
+    
+    NSIndexSet *indexSet = [a safe_indexesOfObjectsConformingToProtocol:@protocol(FFCTestProtocol)];
+    
+    XCTAssertEqualObjects(indexSet, [NSIndexSet indexSetWithIndex:1], @"each object overriding -conformsToProtocol: should be asked directly");
+}
 
-#pragma mark - NSOrderedSet Tests
+#pragma mark - Filtering
 
-@implementation FFCOrderedSetTest
+- (void)testObjectsOfKind
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCProtocolTestObject new]];
+    
+    XCTAssertEqualObjects([a safe_objectsOfKind:[FFCTestObject class]], (@[a[1], a[3]]), @"should return the objects of kind in order");
+    XCTAssertEqualObjects([a safe_objectsOfKind:[NSString class]], @[], @"should return an empty array when nothing matches");
+}
 
-#pragma mark - Responds to Selector
+- (void)testObjectsOfKindSpillsBeyondStackBuffer
+{
+    NSMutableArray *a = [NSMutableArray array];
+    NSMutableArray *expected = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        FFCTestObject *obj = [FFCTestObject new];
+        [a addObject:obj];
+        [a addObject:[NSObject new]];
+        [expected addObject:obj];
+    }
+    
+    XCTAssertEqualObjects([a safe_objectsOfKind:[FFCTestObject class]], expected, @"should return every object of kind in large arrays");
+}
 
-- (void)testRespondsToSelector
+- (void)testObjectsConformingToProtocol
 {
-    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
-    NSOrderedSet *s= [NSOrderedSet orderedSetWithArray:a];
-    
-    XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
-        [obj method];
-    }], @"Should be able to enumerate objects responding to selector without raising.");
+    NSArray *a = @[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]];
     
-    XCTAssertTrue([FFCTestObject safe_cast:a[1]].methodCalled, @"known objects should have had methods called on it");
-    XCTAssertTrue([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertEqualObjects([a safe_objectsConformingToProtocol:@protocol(FFCTestProtocol)], (@[a[1], a[3]]), @"should return the objects conforming to the protocol in order");
 }
 
-- (void)testRespondsToSelectorWithOptions
+- (void)testObjectsRespondingToSelector
 {
     NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
-    NSOrderedSet *s= [NSOrderedSet orderedSetWithArray:a];
-    
-    XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) withOptions:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
-        [obj method];
-    }], @"Should be able to enumerate objects responding to selector without raising.");
     
-    XCTAssertTrue([FFCTestObject safe_cast:a[1]].methodCalled, @"known objects should have had methods called on it");
-    XCTAssertTrue([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertEqualObjects([a safe_objectsRespondingToSelector:@selector(method)], (@[a[1], a[3]]), @"should return the objects responding to the selector in order");
 }
 
-- (void)testRespondsToSelectorAtIndicesWithOptions
+#pragma mark - Fast Enumeration
+
+- (void)testFastEnumerationOfKind
 {
-    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
-    NSIndexSet *i = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)];
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:a];
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCProtocolTestObject new]];
+    NSMutableArray *enumerated = [NSMutableArray array];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) atIndexes:i options:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
-        [obj method];
-    }], @"Should be able to enumerate objects responding to selector without raising.");
+    for (FFCTestObject *obj in [a safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        [enumerated addObject:obj];
+    }
     
-    XCTAssertTrue([FFCTestObject safe_cast:a[1]].methodCalled, @"known objects should have had methods called on it");
-    XCTAssertFalse([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertEqualObjects(enumerated, (@[a[1], a[3]]), @"should enumerate only objects of kind, in order");
 }
 
-#pragma mark - Kind of Class
+- (void)testFastEnumerationOfKindAcrossBatches
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:(i % 3 == 0) ? [FFCTestObject new] : [NSObject new]];
+    }
+    NSUInteger count = 0;
+    
+    for (FFCTestObject *obj in [a safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        XCTAssertTrue([obj isKindOfClass:[FFCTestObject class]], @"should enumerate only objects of kind");
+        count++;
+    }
+    
+    XCTAssertEqual(count, (NSUInteger)334, @"should enumerate every object of kind");
+}
 
-- (void)testEnumerateObjectsOfKindUsingBlock
+- (void)testFastEnumerationStopsOnBreak
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
+    NSArray *a = @[[FFCTestObject new], [NSObject new], [FFCTestObject new]];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
-                                    usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                        [obj setNumber:@3];
-                                    }], @"Objects that do not implement `-setNumber` should not raise");
+    for (FFCTestObject *obj in [a safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        obj.number = @3;
+        break;
+    }
     
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertEqualObjects([a[0] number], @3, @"the first object of kind should be enumerated");
+    XCTAssertNil([a[2] number], @"objects should not be enumerated after breaking out of the loop");
 }
 
-- (void)testStoppingBlockEnumeration
+- (void)testFastEnumerationConformingToProtocolAndRespondingToSelector
 {
-        NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
-    
-    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
-                                    usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                        [obj setNumber:@3];
-                                        *stop = YES;
-                                    }], @"Objects that do not implement `-setNumber` should not raise");
-    
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertNil([FFCTestObject safe_cast:s[3]].number, @"objects should not be enumerated after a block indicated enumaration should stop");
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [FFCProtocolTestObject new]];
+    NSMutableArray *conforming = [NSMutableArray array];
+    NSMutableArray *responding = [NSMutableArray array];
+    
+    for (id obj in [a safe_fastEnumerationConformingToProtocol:@protocol(FFCTestProtocol)]) {
+        [conforming addObject:obj];
+    }
+    for (id obj in [a safe_fastEnumerationRespondingToSelector:@selector(method)]) {
+        [responding addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(conforming, @[a[2]], @"should enumerate only objects conforming to the protocol");
+    XCTAssertEqualObjects(responding, (@[a[1], a[2]]), @"should enumerate only objects responding to the selector");
 }
 
-- (void)testEnumerateObjectsOfKindAtIndexesOptionsUsingBlock
+#pragma mark - Chunked Concurrent Enumeration
+
+- (void)testEnumerateObjectsOfKindConcurrently
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
-    
-    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
-                                          atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
-                                            options:kNilOptions
-                                         usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                             [obj setNumber:@3];
-                                         }], @"Objects that do not implement `-setNumber` should not raise");
-    
-    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 10000; i++) {
+        [a addObject:(i % 2 == 0) ? [FFCTestObject new] : [NSObject new]];
+    }
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSet];
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:100 usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqual(obj, a[idx], @"indexes should refer to the enumerated object");
+        @synchronized (visited) {
+            [visited addIndex:idx];
+        }
+    }];
+    
+    XCTAssertEqualObjects(visited, [a safe_indexesOfObjectsOfKind:[FFCTestObject class]], @"every object of kind should be enumerated exactly once");
 }
 
-- (void)testEnumerateObjectsOfKindAtIndexesOptionsUsingBlock_legacy
+- (void)testEnumerateObjectsConformingToProtocolAndRespondingToSelectorConcurrently
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wdeprecated-declarations"
-    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
-                                     AtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
-                                       options:kNilOptions
-                                    usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                        [obj setNumber:@3];
-                                    }], @"Objects that do not implement `-setNumber` should not raise");
-    #pragma clang diagnostic pop
-    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+    NSArray *a = @[[FFCTestObject new], [FFCProtocolTestObject new], [NSObject new], [FFCProtocolTestObject new]];
+    NSMutableIndexSet *conforming = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *responding = [NSMutableIndexSet indexSet];
+    
+    [a safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol) concurrentlyWithGrainSize:1 usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        @synchronized (conforming) {
+            [conforming addIndex:idx];
+        }
+    }];
+    [a safe_enumerateObjectsRespondingToSelector:@selector(method) concurrentlyWithGrainSize:0 usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        @synchronized (responding) {
+            [responding addIndex:idx];
+        }
+    }];
+    
+    NSMutableIndexSet *expectedResponding = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)];
+    [expectedResponding addIndex:3];
+    XCTAssertEqualObjects(conforming, ([a safe_indexesOfObjectsConformingToProtocol:@protocol(FFCTestProtocol)]), @"every conforming object should be enumerated");
+    XCTAssertEqualObjects(responding, expectedResponding, @"every responding object should be enumerated");
 }
 
-- (void)testIndexesOfObjectsOfKind
+- (void)testStoppingConcurrentEnumeration
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, @2, [FFCTestObject new], [FFCProtocolTestObject new]]];
-    NSIndexSet *indexSet = [s safe_indexesOfObjectsOfKind:[FFCTestObject class]];
-    
-    XCTAssertEqualObjects(indexSet, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)], @"should return an index set corresponding to the objects of kind");
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 100000; i++) {
+        [a addObject:[FFCTestObject new]];
+    }
+    __block NSUInteger visited = 0;
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:10 usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+        @synchronized (a) {
+            visited++;
+        }
+        *stop = YES;
+    }];
+    
+    XCTAssertLessThan(visited, a.count, @"objects should not all be enumerated after a block indicated enumeration should stop");
 }
 
-#pragma mark - Conforms to Protocol
+#pragma mark - Of Kinds
 
-- (void)testEnumerateObjectsConformingToProtocolUsingBlock
+- (void)testEnumerateObjectsOfKindsUsingBlock
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    NSArray *a = @[[NSObject new], @"string", [FFCTestObject new], @3, [FFCProtocolTestObject new]];
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSet];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
-                                                  usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                                      [obj setNumber:@3];
-                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    [a safe_enumerateObjectsOfKinds:@[[NSString class], [NSNumber class]] usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [visited addIndex:idx];
+    }];
     
-    XCTAssertNil([FFCTestObject safe_cast:s[0]].number, @"objects not conforming to the protocol should not have had methods called on it");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertNil([FFCTestObject safe_cast:s[2]].number, @"objects not conforming to the protocol should not have had methods called on it");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertEqualObjects(visited, ([a safe_indexesOfObjectsOfKinds:@[[NSNumber class], [NSString class]]]), @"Only objects of any of the kinds should be enumerated");
+    XCTAssertEqual(visited.count, (NSUInteger)2, @"Only strings and numbers should be enumerated");
+    XCTAssertTrue([visited containsIndex:1] && [visited containsIndex:3], @"Only strings and numbers should be enumerated");
 }
 
-- (void)testStoppingBlockEnumerationConformingToProtocol
+- (void)testEnumerateObjectsOfKindsWithReusedClassSet
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    NSArray *a = @[[NSObject new], [FFCTestObject new], @3, [FFCProtocolTestObject new]];
+    SafeCastClassSet *classSet = [SafeCastClassSet classSetWithClasses:@[[FFCTestObject class], [NSNumber class]]];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
-                                                  usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                                      [obj setNumber:@3];
-                                                      *stop = YES;
-                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    for (NSUInteger i = 0; i < 2; i++) {
+        XCTAssertEqualObjects([a safe_indexesOfObjectsOfKinds:classSet], [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 3)], @"A class set should give the same answers each time it is used");
+    }
+}
+
+- (void)testEnumerateObjectsOfKindsWithOptionsAndAtIndexes
+{
+    NSArray *a = @[[FFCTestObject new], @"string", [FFCTestObject new], [FFCProtocolTestObject new]];
+    NSArray *classes = @[[FFCTestObject class], [NSString class]];
+    
+    [a safe_enumerateObjectsOfKinds:classes withOptions:NSEnumerationReverse usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [[FFCTestObject safe_cast:obj] setNumber:@3];
+        *stop = YES;
+    }];
+    XCTAssertNil([a[0] number], @"Reverse enumeration should stop before reaching the first object");
+    XCTAssertEqualObjects([a[3] number], @3, @"Reverse enumeration should start with the last object");
+    
+    [a safe_enumerateObjectsOfKinds:classes atIndexes:[NSIndexSet indexSetWithIndex:2] options:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [obj setNumber:@4];
+    }];
+    XCTAssertNil([a[0] number], @"Objects outside the index set should not be enumerated");
+    XCTAssertEqualObjects([a[2] number], @4, @"Objects in the index set should be enumerated");
+}
+
+#pragma mark - Matching a Filter
+
+- (void)testEnumerateObjectsMatchingFilter
+{
+    FFCSelectiveTestObject *responding = [FFCSelectiveTestObject new];
+    responding.respondsToMethod = YES;
+    NSArray *a = @[[FFCTestObject new], [FFCProtocolTestObject new], responding, [FFCSelectiveTestObject new], [FFCProtocolTestObject new]];
+    SafeCastFilter *filter = [SafeCastFilter filterMatchingAnyOf:@[[SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:[FFCTestObject class]],
+                                                                                                           [SafeCastFilter filterConformingToProtocol:@protocol(FFCTestProtocol)]]],
+                                                                   [SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterNegatingFilter:[SafeCastFilter filterOfKind:[FFCTestObject class]]],
+                                                                                                           [SafeCastFilter filterRespondingToSelector:@selector(method)]]]]];
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSet];
+    
+    [a safe_enumerateObjectsMatchingFilter:filter usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [visited addIndex:idx];
+    }];
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:1];
+    [expected addIndex:2];
+    [expected addIndex:4];
+    XCTAssertEqualObjects(visited, expected, @"Only objects matching the filter should be enumerated");
+    XCTAssertEqualObjects([a safe_indexesOfObjectsMatchingFilter:filter], expected, @"Only indexes of objects matching the filter should be returned");
+}
+
+- (void)testEnumerateObjectsMatchingFilterAtIndexes
+{
+    NSArray *a = @[[FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]];
+    SafeCastFilter *filter = [SafeCastFilter filterConformingToProtocol:@protocol(FFCTestProtocol)];
     
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertNil([FFCTestObject safe_cast:s[3]].number, @"objects should not be enumerated after a block indicated enumaration should stop");
+    [a safe_enumerateObjectsMatchingFilter:filter atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)] options:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [obj setNumber:@3];
+    }];
     
+    XCTAssertNil([a[0] number], @"Objects outside the index set should not be enumerated");
+    XCTAssertNil([a[1] number], @"Objects not matching the filter should not be enumerated");
+    XCTAssertEqualObjects([a[2] number], @3, @"Matching objects in the index set should be enumerated");
 }
 
-- (void)testEnumerateConformingToProtocolAtIndexesOptionsUsingBlock
+#pragma mark - Partitioning
+
+- (void)testPartitionObjectsByKinds
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSObject *obj3 = [NSObject new];
+    NSArray *a = @[@1, obj1, @"a", obj2, obj3, @2, @"b"];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
-                                                        atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
-                                                          options:kNilOptions
-                                                       usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                                           [obj setNumber:@3];
-                                                       }], @"Objects that do not implement `-setNumber` should not raise");
+    NSArray *partitions = [a safe_partitionObjectsByKinds:@[[NSString class], [FFCTestObject class], [NSNumber class], [NSDictionary class]]];
     
-    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
-    XCTAssertNil([FFCTestObject safe_cast:s[2]].number, @"objects not conforming to the protocol should not have had methods called on it");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertEqual(partitions.count, (NSUInteger)5, @"There should be one bucket per class and an unmatched bucket");
+    XCTAssertEqualObjects(partitions[0], (@[@"a", @"b"]), @"Strings should be bucketed in order");
+    XCTAssertEqualObjects(partitions[1], (@[obj1, obj2]), @"Subclasses should be bucketed with their superclass");
+    XCTAssertEqualObjects(partitions[2], (@[@1, @2]), @"Numbers should be bucketed in order");
+    XCTAssertEqualObjects(partitions[3], @[], @"Classes with no objects should have an empty bucket");
+    XCTAssertEqualObjects(partitions[4], @[obj3], @"Objects of no listed kind should be in the unmatched bucket");
 }
 
-- (void)testEnumerateConformingToProtocolAtIndexesOptionsUsingBlock_legacy
+- (void)testPartitionObjectsByKindsPrefersEarlierClasses
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wdeprecated-declarations"
-    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
-                                                   AtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
-                                                     options:kNilOptions
-                                                  usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
-                                                      [obj setNumber:@3];
-                                                  }], @"Objects that do not implement `-setNumber` should not raise");
-    #pragma clang diagnostic pop
-    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
-    XCTAssertNil([FFCTestObject safe_cast:s[2]].number, @"objects not conforming to the protocol should not have had methods called on it");
-    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    NSArray *partitions = [@[obj] safe_partitionObjectsByKinds:@[[FFCProtocolTestObject class], [FFCTestObject class]]];
+    
+    XCTAssertEqualObjects(partitions[0], @[obj], @"An object should go into the bucket of the first class it is a kind of");
+    XCTAssertEqualObjects(partitions[1], @[], @"An object should only be in one bucket");
 }
 
-- (void)testIndexesOfObjectsConformingToProtocol
+- (void)testPartitionObjectsByKindsBeyondStackBuffer
 {
-    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [FFCProtocolTestObject new], [FFCProtocolTestObject new], @3, @4]];
-    NSIndexSet *indexSet = [s safe_indexesOfObjectsConformingToProtocol:@protocol(FFCTestProtocol)];
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:(i % 3 == 0) ? [FFCTestObject new] : @(i)];
+    }
     
-    XCTAssertEqualObjects(indexSet, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)], @"should return an index set corresponding to the objects of kind");
+    NSArray *partitions = [a safe_partitionObjectsByKinds:@[[FFCTestObject class]]];
+    
+    XCTAssertEqual([partitions[0] count], (NSUInteger)334, @"Every object of the kind should be bucketed");
+    XCTAssertEqual([partitions[1] count], (NSUInteger)666, @"Every other object should be unmatched");
+    XCTAssertEqualObjects(partitions[1][0], @1, @"Unmatched objects should keep their order");
 }
 
-@end
+#pragma mark - Aggregate Queries
 
-#pragma mark - NSSet Tests
+- (void)testAggregateQueriesOfKind
+{
+    FFCTestObject *first = [FFCTestObject new];
+    FFCProtocolTestObject *last = [FFCProtocolTestObject new];
+    NSArray *a = @[@1, first, @2, last, @3];
+    
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[FFCTestObject class]], (NSUInteger)2, @"Every object of the kind should be counted");
+    XCTAssertEqual([a safe_firstObjectOfKind:[FFCTestObject class]], first, @"The first object of the kind should be returned");
+    XCTAssertEqual([a safe_lastObjectOfKind:[FFCTestObject class]], last, @"The last object of the kind should be returned");
+    XCTAssertTrue([a safe_containsObjectOfKind:[FFCTestObject class]], @"An array with objects of the kind should contain one");
+    XCTAssertFalse([a safe_containsObjectOfKind:[NSString class]], @"An array without strings should not contain one");
+    XCTAssertNil([a safe_firstObjectOfKind:[NSString class]], @"There should be no first string");
+    XCTAssertNil([a safe_lastObjectOfKind:[NSString class]], @"There should be no last string");
+    XCTAssertEqual([@[] safe_countOfObjectsOfKind:[NSObject class]], (NSUInteger)0, @"An empty array should count nothing");
+}
 
-@implementation FFCSetTest
+- (void)testAggregateQueriesConformingToProtocolAndRespondingToSelector
+{
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    FFCSelectiveTestObject *responding = [FFCSelectiveTestObject new];
+    responding.respondsToMethod = YES;
+    NSArray *a = @[[FFCSelectiveTestObject new], obj, responding, [NSObject new]];
+    
+    XCTAssertEqual([a safe_countOfObjectsConformingToProtocol:@protocol(FFCTestProtocol)], (NSUInteger)1, @"Every conforming object should be counted");
+    XCTAssertEqual([a safe_firstObjectConformingToProtocol:@protocol(FFCTestProtocol)], obj, @"The conforming object should be found");
+    XCTAssertEqual([a safe_countOfObjectsRespondingToSelector:@selector(method)], (NSUInteger)2, @"Each instance's answer to -respondsToSelector: should be respected");
+    XCTAssertEqual([a safe_lastObjectRespondingToSelector:@selector(method)], responding, @"The last responding object should be found");
+    XCTAssertEqual([a safe_firstObjectRespondingToSelector:@selector(method)], obj, @"The first responding object should be found");
+    XCTAssertFalse([a safe_containsObjectRespondingToSelector:@selector(count)], @"No object responds to -count");
+}
 
-#pragma mark - Responds to Selector
+- (void)testLastObjectOfKindAcrossBatches
+{
+    NSMutableArray *a = [NSMutableArray array];
+    FFCTestObject *expected = [FFCTestObject new];
+    [a addObject:expected];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:@(i)];
+    }
+    
+    XCTAssertEqual([a safe_lastObjectOfKind:[FFCTestObject class]], expected, @"The search should continue across batches to the start of the array");
+    XCTAssertEqualObjects([a safe_lastObjectOfKind:[NSNumber class]], @999, @"The last object should be found first");
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[NSNumber class]], (NSUInteger)1000, @"Every object of the kind should be counted across batches");
+}
 
-- (void)testMakeObjectSafelyPerformSelector
+#pragma mark - Index Sets
+
+- (void)testIndexesOfObjectsRespondingToSelector
 {
-    FFCTestObject *obj1 = [FFCTestObject new];
-    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
-    NSSet *s = [NSSet setWithArray:@[@1, obj1, @2, obj2]];
+    FFCSelectiveTestObject *responding = [FFCSelectiveTestObject new];
+    responding.respondsToMethod = YES;
+    NSArray *a = @[[NSObject new], [FFCTestObject new], responding, [FFCSelectiveTestObject new], [FFCProtocolTestObject new]];
     
-    XCTAssertNoThrow([s safe_makeObjectsSafelyPerformSelector:@selector(method)], @"Objects that do not implement `-method` should not raise");
-    XCTAssertTrue(obj1.methodCalled, @"known objects should have had methods called on it");
-    XCTAssertTrue(obj2.methodCalled, @"known objects should have had methods called on it");
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)];
+    [expected addIndex:4];
+    XCTAssertEqualObjects([a safe_indexesOfObjectsRespondingToSelector:@selector(method)], expected, @"should return the indexes of objects responding to the selector");
 }
 
-- (void)testMakeObjectSafelyPerformSelectorWithObject
+- (void)testIndexesOfObjectsOfKindCoalescesRuns
+{
+    NSMutableArray *a = [NSMutableArray array];
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        BOOL match = (i >= 100 && i < 400) || i % 7 == 0;
+        [a addObject:match ? [FFCTestObject new] : [NSObject new]];
+        if (match) {
+            [expected addIndex:i];
+        }
+    }
+    
+    XCTAssertEqualObjects([a safe_indexesOfObjectsOfKind:[FFCTestObject class]], expected, @"Runs and scattered matches should both be returned exactly");
+    XCTAssertEqualObjects([a safe_indexesOfObjectsOfKind:[NSString class]], [NSIndexSet indexSet], @"No matches should return an empty index set");
+}
+
+#pragma mark - Compaction
+
+- (void)testRemoveObjectsNotOfKind
 {
     FFCTestObject *obj1 = [FFCTestObject new];
     FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
-    NSSet *s = [NSSet setWithArray:@[@1, obj1, @2, obj2]];
+    NSMutableArray *a = [@[@1, obj1, @"a", @"b", obj2, @2] mutableCopy];
     
-    XCTAssertNoThrow([s safe_makeObjectsSafelyPerformSelector:@selector(setNumber:) withObject:@3], @"Objects that do not implement `-setNumber:` should not raise");
-    XCTAssertEqualObjects(obj1.number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertEqualObjects(obj2.number, @3, @"known objects should have had methods called on it with correct object");
+    [a safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqualObjects(a, (@[obj1, obj2]), @"Only objects of the kind should remain, in order");
 }
 
-- (void)testRespondsToSelector
+- (void)testRemoveObjectsNotConformingToProtocolAndRespondingToSelector
 {
-    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
-    NSSet *s= [NSSet setWithArray:a];
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    FFCTestObject *responding = [FFCTestObject new];
+    NSMutableArray *a = [@[obj, @1, responding, [NSObject new]] mutableCopy];
+    
+    [a safe_removeObjectsNotRespondingToSelector:@selector(method)];
+    XCTAssertEqualObjects(a, (@[obj, responding]), @"Only objects responding to the selector should remain");
+    
+    [a safe_removeObjectsNotConformingToProtocol:@protocol(FFCTestProtocol)];
+    XCTAssertEqualObjects(a, @[obj], @"Only conforming objects should remain");
+    
+    [a safe_removeObjectsNotConformingToProtocol:@protocol(FFCTestProtocol)];
+    XCTAssertEqualObjects(a, @[obj], @"Compacting an already compact array should change nothing");
+}
+
+- (void)testRemoveObjectsNotOfKindKeepsMovedObjectsAlive
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:(i % 2) ? [FFCTestObject new] : [NSObject new]];
+    }
+    
+    [a safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqual(a.count, (NSUInteger)500, @"Every object of the kind should remain");
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[FFCTestObject class]], (NSUInteger)500, @"Only objects of the kind should remain");
+}
+
+#pragma mark - Enumerating with a Function
+
+- (void)testEnumerateObjectsOfKindWithFunction
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], @1, [FFCProtocolTestObject new]];
+    NSUInteger calls = 0;
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] function:FFCSetNumberAtIndex context:&calls];
+    
+    XCTAssertEqual(calls, (NSUInteger)2, @"The function should be called once per object of the kind");
+    XCTAssertEqualObjects([a[1] number], @1, @"The function should receive each object's index");
+    XCTAssertEqualObjects([a[3] number], @3, @"The function should receive each object's index");
+}
+
+- (void)testEnumerateObjectsWithFunctionStops
+{
+    NSArray *a = @[[FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]];
+    
+    [a safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol) function:FFCSetNumberAndStop context:NULL];
+    
+    XCTAssertEqualObjects([a[0] number], @3, @"The first conforming object should be visited");
+    XCTAssertNil([a[2] number], @"Objects should not be visited after the function sets stop");
+}
+
+- (void)testEnumerateObjectsRespondingToSelectorWithFunction
+{
+    FFCSelectiveTestObject *responding = [FFCSelectiveTestObject new];
+    responding.respondsToMethod = YES;
+    NSArray *a = @[[FFCSelectiveTestObject new], responding, [NSObject new]];
+    NSUInteger calls = 0;
+    
+    XCTAssertThrowsSpecificNamed([a safe_enumerateObjectsRespondingToSelector:@selector(method) function:NULL context:NULL], NSException, NSInvalidArgumentException, @"A NULL function should raise");
+    [a safe_enumerateObjectsRespondingToSelector:@selector(number) function:FFCSetNumberAtIndex context:&calls];
+    XCTAssertEqual(calls, (NSUInteger)0, @"No object responds to -number");
+}
+
+#pragma mark - Direct Block Enumeration
+
+- (void)testEnumerateObjectsOfKindInReverseAcrossBatches
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 200; i++) {
+        [a addObject:(i % 3 ? [FFCTestObject new] : [NSObject new])];
+    }
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] withOptions:NSEnumerationReverse usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqual(obj, a[idx], @"The block should receive each object's index");
+        [visited addObject:@(idx)];
+    }];
+    
+    NSMutableArray *expected = [NSMutableArray array];
+    for (NSUInteger i = 200; i > 0; i--) {
+        if ((i - 1) % 3) {
+            [expected addObject:@(i - 1)];
+        }
+    }
+    XCTAssertEqualObjects(visited, expected, @"Objects of the kind should be visited from last to first");
+}
+
+- (void)testEnumerateObjectsOfKindAtIndexesInReverseStops
+{
+    NSArray *a = @[[FFCTestObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new], [FFCTestObject new], [FFCTestObject new]];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)];
+    [indexes addIndexesInRange:NSMakeRange(3, 2)];
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] atIndexes:indexes options:NSEnumerationReverse usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+        [visited addObject:@(idx)];
+        *stop = idx == 1;
+    }];
+    
+    XCTAssertEqualObjects(visited, (@[@4, @3, @1]), @"Ranges and the objects within them should be visited from last to first until the block stops");
+}
+
+- (void)testEnumerateObjectsOfKindAtIndexesConcurrently
+{
+    NSArray *a = @[[FFCTestObject new], [NSObject new], [FFCTestObject new], [FFCTestObject new]];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSetWithIndex:1];
+    [indexes addIndex:3];
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] atIndexes:indexes options:NSEnumerationConcurrent usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+        [obj setNumber:@(idx)];
+    }];
+    
+    XCTAssertNil([a[0] number], @"Objects outside the index set should not be visited");
+    XCTAssertNil([a[2] number], @"Objects outside the index set should not be visited");
+    XCTAssertEqualObjects([a[3] number], @3, @"Objects of the kind in the index set should be visited with their index");
+}
+
+- (void)testEnumerateObjectsOfKindAtIndexesBeyondBoundsRaises
+{
+    NSArray *a = @[[FFCTestObject new]];
+    
+    XCTAssertThrowsSpecificNamed([a safe_enumerateObjectsOfKind:[FFCTestObject class] atIndexes:[NSIndexSet indexSetWithIndex:1] options:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {}], NSException, NSRangeException, @"Indexes beyond the end of the array should raise");
+}
+
+- (void)testEnumerateObjectsOfKindWithNilBlockRaises
+{
+    NSArray *a = @[[FFCTestObject new]];
+    void (^block)(id, NSUInteger, BOOL *) = nil;
+    
+    XCTAssertThrowsSpecificNamed([a safe_enumerateObjectsOfKind:[FFCTestObject class] usingBlock:block], NSException, NSInvalidArgumentException, @"A nil block should raise");
+}
+
+- (void)testMutatingDuringEnumerationRaises
+{
+    NSMutableArray *a = [NSMutableArray arrayWithObjects:[FFCTestObject new], [FFCTestObject new], nil];
+    
+    XCTAssertThrows([a safe_enumerateObjectsOfKind:[FFCTestObject class] usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [a addObject:[FFCTestObject new]];
+    }], @"Mutating an array while enumerating it should raise");
+    XCTAssertThrows([a safe_enumerateObjectsOfKind:[FFCTestObject class] withOptions:NSEnumerationReverse usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [a removeLastObject];
+    }], @"Mutating an array while enumerating it in reverse should raise");
+}
+
+#pragma mark - Lazy Views
+
+- (void)testLazyArrayOfKind
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 300; i++) {
+        [a addObject:(i % 4 ? [NSObject new] : [FFCTestObject new])];
+    }
+    NSArray *expected = [a safe_objectsOfKind:[FFCTestObject class]];
+    
+    NSArray *lazy = [a safe_lazyArrayOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqual(lazy[1], expected[1], @"Elements should be found before the count is known");
+    XCTAssertEqual(lazy.count, expected.count, @"The view should count only objects of the kind");
+    XCTAssertEqualObjects(lazy, expected, @"The view should hold the objects of the kind in order");
+    XCTAssertThrowsSpecificNamed(lazy[expected.count], NSException, NSRangeException, @"Indexes beyond the view should raise");
+}
+
+- (void)testLazyArrayFastEnumeration
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [FFCProtocolTestObject new], @1, [FFCTestObject new]];
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    for (id obj in [a safe_lazyArrayConformingToProtocol:@protocol(FFCTestProtocol)]) {
+        [visited addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(visited, [a safe_objectsConformingToProtocol:@protocol(FFCTestProtocol)], @"For-in loops should visit only matching objects in order");
+}
+
+- (void)testLazyArraySharesAnUnmutatedSource
+{
+    NSMutableArray *a = [NSMutableArray arrayWithObjects:[FFCTestObject new], [NSObject new], [FFCTestObject new], nil];
+    
+    NSArray *lazy = [a safe_lazyArrayOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqual(lazy.count, (NSUInteger)2, @"The view should see every match in a mutable source");
+    XCTAssertEqual(lazy[1], a[2], @"The view should return the source's own objects");
+}
+
+- (void)testLazyArrayRaisesAfterTheSourceIsMutated
+{
+    NSMutableArray *a = [NSMutableArray arrayWithObjects:[FFCTestObject new], [NSObject new], nil];
+    
+    NSArray *lazy = [a safe_lazyArrayOfKind:[FFCTestObject class]];
+    [a removeAllObjects];
+    
+    XCTAssertThrowsSpecificNamed(lazy.count, NSException, NSGenericException, @"Counting a view of a mutated source should raise");
+    XCTAssertThrowsSpecificNamed(lazy[0], NSException, NSGenericException, @"Reading a view of a mutated source should raise");
+    XCTAssertThrows(^{
+        for (id obj in lazy) {
+            (void)obj;
+        }
+    }(), @"Enumerating a view of a mutated source should raise");
+}
+
+- (void)testLazyArrayOfAnEmptySourceRaisesAfterTheSourceGainsObjects
+{
+    NSMutableArray *a = [NSMutableArray array];
+    
+    NSArray *lazy = [a safe_lazyArrayOfKind:[FFCTestObject class]];
+    XCTAssertEqual(lazy.count, (NSUInteger)0, @"A view of an empty array should be empty");
+    [a addObject:[FFCTestObject new]];
+    
+    XCTAssertThrowsSpecificNamed(lazy.count, NSException, NSGenericException, @"A view of an empty array should notice objects added to it");
+}
+
+- (void)testCopyOfLazyArrayOutlivesMutatingTheSource
+{
+    FFCTestObject *obj = [FFCTestObject new];
+    NSMutableArray *a = [NSMutableArray arrayWithObjects:obj, [NSObject new], nil];
+    NSArray *immutable = [a copy];
+    
+    NSArray *copy = [[a safe_lazyArrayOfKind:[FFCTestObject class]] copy];
+    [a removeAllObjects];
+    
+    XCTAssertEqualObjects(copy, @[obj], @"A copy of a view of a mutable array should be a snapshot of the matches");
+    NSArray *lazy = [immutable safe_lazyArrayOfKind:[FFCTestObject class]];
+    XCTAssertEqual([lazy copy], lazy, @"A view of an immutable array should be its own copy");
+}
+
+#pragma mark - Reducing and Mapping
+
+- (void)testReduceObjectsOfKind
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 5000; i++) {
+        FFCTestObject *obj = [FFCTestObject new];
+        obj.number = @(i);
+        [a addObject:(i % 3 ? obj : [NSObject new])];
+    }
+    id (^combine)(id, id) = ^id(NSArray *accumulator, FFCTestObject *obj) {
+        return [accumulator arrayByAddingObject:obj.number];
+    };
+    id (^merge)(id, id) = ^id(NSArray *left, NSArray *right) {
+        return [left arrayByAddingObjectsFromArray:right];
+    };
+    
+    NSArray *serial = [a safe_reduceObjectsOfKind:[FFCTestObject class] initial:@[] combine:combine merge:nil];
+    NSArray *concurrent = [a safe_reduceObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:100 initial:@[] combine:combine merge:merge];
+    
+    XCTAssertEqualObjects(serial, [[a safe_objectsOfKind:[FFCTestObject class]] valueForKey:@"number"], @"Objects of the kind should be combined in order");
+    XCTAssertEqualObjects(concurrent, serial, @"Partial results should be merged in order");
+    XCTAssertEqualObjects([@[] safe_reduceObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:0 initial:@7 combine:combine merge:merge], @7, @"Reducing an empty array should return the initial value");
+}
+
+- (void)testCompactMapObjectsOfKind
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 5000; i++) {
+        FFCTestObject *obj = [FFCTestObject new];
+        obj.number = (i % 2 ? @(i) : nil);
+        [a addObject:(i % 5 ? obj : [NSObject new])];
+    }
+    NSMutableArray *expected = [NSMutableArray array];
+    for (FFCTestObject *obj in [a safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        if (obj.number) {
+            [expected addObject:obj.number];
+        }
+    }
+    
+    NSArray *serial = [a safe_compactMapObjectsOfKind:[FFCTestObject class] usingBlock:^id(FFCTestObject *obj) {
+        return obj.number;
+    }];
+    NSArray *concurrent = [a safe_compactMapObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:64 usingBlock:^id(FFCTestObject *obj) {
+        return obj.number;
+    }];
+    
+    XCTAssertEqualObjects(serial, expected, @"Non-nil results should be collected in order");
+    XCTAssertEqualObjects(concurrent, expected, @"Non-nil results from every chunk should be collected in order");
+}
+
+- (void)testReduceObjectsRespondingToSelectorWithNilCombineRaises
+{
+    NSArray *a = @[[FFCTestObject new]];
+    id (^combine)(id, id) = nil;
+    
+    XCTAssertThrowsSpecificNamed([a safe_reduceObjectsRespondingToSelector:@selector(method) initial:nil combine:combine merge:nil], NSException, NSInvalidArgumentException, @"A nil combine block should raise");
+}
+
+#pragma mark - Mapping a Selector
+
+- (void)testMapObjectsPerformingSelector
+{
+    FFCTestObject *first = [FFCTestObject new];
+    FFCTestObject *second = [FFCTestObject new];
+    FFCTestObject *unnumbered = [FFCTestObject new];
+    first.number = @1;
+    second.number = @2;
+    NSArray *a = @[[NSObject new], first, unnumbered, @3, second];
+    SEL missing = NULL;
+    
+    XCTAssertEqualObjects([a safe_mapObjectsPerformingSelector:@selector(number)], (@[@1, @2]), @"Non-nil results from responding objects should be collected in order");
+    XCTAssertEqualObjects([@[] safe_mapObjectsPerformingSelector:@selector(number)], @[], @"An empty array should map to an empty array");
+    XCTAssertThrowsSpecificNamed([a safe_mapObjectsPerformingSelector:missing], NSException, NSInvalidArgumentException, @"A NULL selector should raise");
+}
+
+- (void)testMapObjectsPerformingSelectorWithObject
+{
+    NSArray *a = @[@"a", [NSObject new], @"b"];
+    
+    XCTAssertEqualObjects([a safe_mapObjectsPerformingSelector:@selector(stringByAppendingString:) withObject:@"!"], (@[@"a!", @"b!"]), @"The argument should be passed to each responding object");
+}
+
+- (void)testMapObjectsPerformingSelectorAcrossManyBatches
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        FFCTestObject *obj = [FFCTestObject new];
+        obj.number = @(i);
+        [a addObject:(i % 4 ? (id)obj : [NSObject new])];
+    }
+    
+    NSArray *numbers = [a safe_mapObjectsPerformingSelector:@selector(number)];
+    
+    XCTAssertEqual(numbers.count, (NSUInteger)750, @"Every responding object should contribute a result");
+    XCTAssertEqualObjects(numbers.lastObject, @999, @"Results should be in array order");
+}
+
+- (void)testMapObjectsPerformingSelectorSkipsNonObjectReturns
+{
+    FFCTestObject *numbered = [FFCTestObject new];
+    numbered.number = @1;
+    NSArray *a = @[numbered, [NSObject new], @"string"];
+    
+    XCTAssertEqualObjects([a safe_mapObjectsPerformingSelector:@selector(hash)], @[], @"Methods returning scalars should be skipped");
+    XCTAssertEqualObjects([a safe_mapObjectsPerformingSelector:@selector(method)], @[], @"Methods returning void should be skipped");
+    XCTAssertEqualObjects([@[numbered, @2] safe_mapObjectsPerformingSelector:@selector(number)], @[@1], @"Objects returning objects should still be collected");
+}
+
+- (void)testMapObjectsPerformingSelectorRejectsRetainedReturns
+{
+    NSArray *a = @[@"string"];
+    
+    XCTAssertThrowsSpecificNamed([a safe_mapObjectsPerformingSelector:@selector(copy)], NSException, NSInvalidArgumentException, @"copy returns a retained object and should raise");
+    XCTAssertThrowsSpecificNamed([a safe_mapObjectsPerformingSelector:@selector(mutableCopy)], NSException, NSInvalidArgumentException, @"mutableCopy returns a retained object and should raise");
+    XCTAssertThrowsSpecificNamed([a safe_mapObjectsPerformingSelector:@selector(init)], NSException, NSInvalidArgumentException, @"init consumes its receiver and should raise");
+    XCTAssertThrowsSpecificNamed([a safe_mapObjectsPerformingSelector:@selector(initWithString:) withObject:@"other"], NSException, NSInvalidArgumentException, @"init methods consume their receiver and should raise");
+    XCTAssertEqualObjects([a safe_mapObjectsPerformingSelector:@selector(uppercaseString)], @[@"STRING"], @"A selector that only contains a family name after its first word should be allowed");
+    XCTAssertEqualObjects([a safe_mapObjectsPerformingSelector:@selector(description)], @[@"string"], @"Selectors outside the retained families should be allowed");
+}
+
+- (void)testConcurrentReductionMergesNilPartials
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:(i == 500) ? [FFCTestObject new] : [NSObject new]];
+    }
+    
+    __block NSUInteger nilMerges = 0;
+    id result = [a safe_reduceObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:10 initial:nil combine:^id(id accumulator, FFCTestObject *obj) {
+        return obj;
+    } merge:^id(id left, id right) {
+        if (left == nil && right == nil) {
+            @synchronized (a) {
+                nilMerges++;
+            }
+        }
+        return left ?: right;
+    }];
+    
+    XCTAssertEqual(result, a[500], @"The one matching object should survive merging with chunks that matched nothing");
+    XCTAssertTrue(nilMerges > 0, @"Chunks without matches should be merged as nil");
+}
+
+@end
+
+#pragma mark - NSOrderedSet Tests
+
+@implementation FFCOrderedSetTest
+
+#pragma mark - Responds to Selector
+
+- (void)testRespondsToSelector
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
+    NSOrderedSet *s= [NSOrderedSet orderedSetWithArray:a];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [obj method];
+    }], @"Should be able to enumerate objects responding to selector without raising.");
+    
+    XCTAssertTrue([FFCTestObject safe_cast:a[1]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertTrue([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+}
+
+- (void)testRespondsToSelectorWithOptions
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
+    NSOrderedSet *s= [NSOrderedSet orderedSetWithArray:a];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) withOptions:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [obj method];
+    }], @"Should be able to enumerate objects responding to selector without raising.");
+    
+    XCTAssertTrue([FFCTestObject safe_cast:a[1]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertTrue([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+}
+
+- (void)testRespondsToSelectorAtIndicesWithOptions
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
+    NSIndexSet *i = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)];
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:a];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) atIndexes:i options:kNilOptions usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [obj method];
+    }], @"Should be able to enumerate objects responding to selector without raising.");
+    
+    XCTAssertTrue([FFCTestObject safe_cast:a[1]].methodCalled, @"known objects should have had methods called on it");
+    XCTAssertFalse([FFCTestObject safe_cast:a[3]].methodCalled, @"known objects should have had methods called on it");
+}
+
+#pragma mark - Kind of Class
+
+- (void)testEnumerateObjectsOfKindUsingBlock
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
+                                    usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                        [obj setNumber:@3];
+                                    }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testStoppingBlockEnumeration
+{
+        NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
+                                    usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                        [obj setNumber:@3];
+                                        *stop = YES;
+                                    }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertNil([FFCTestObject safe_cast:s[3]].number, @"objects should not be enumerated after a block indicated enumaration should stop");
+}
+
+- (void)testEnumerateObjectsOfKindAtIndexesOptionsUsingBlock
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
+                                          atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
+                                            options:kNilOptions
+                                         usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                             [obj setNumber:@3];
+                                         }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testEnumerateObjectsOfKindAtIndexesOptionsUsingBlock_legacy
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2, [FFCProtocolTestObject new]]];
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    XCTAssertNoThrow([s safe_enumerateObjectsOfKind:[FFCTestObject class]
+                                     AtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
+                                       options:kNilOptions
+                                    usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                        [obj setNumber:@3];
+                                    }], @"Objects that do not implement `-setNumber` should not raise");
+    #pragma clang diagnostic pop
+    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testIndexesOfObjectsOfKind
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, @2, [FFCTestObject new], [FFCProtocolTestObject new]]];
+    NSIndexSet *indexSet = [s safe_indexesOfObjectsOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqualObjects(indexSet, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)], @"should return an index set corresponding to the objects of kind");
+}
+
+#pragma mark - Conforms to Protocol
+
+- (void)testEnumerateObjectsConformingToProtocolUsingBlock
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
+                                                  usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                                      [obj setNumber:@3];
+                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertNil([FFCTestObject safe_cast:s[0]].number, @"objects not conforming to the protocol should not have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertNil([FFCTestObject safe_cast:s[2]].number, @"objects not conforming to the protocol should not have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testStoppingBlockEnumerationConformingToProtocol
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
+                                                  usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                                      [obj setNumber:@3];
+                                                      *stop = YES;
+                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[1]].number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertNil([FFCTestObject safe_cast:s[3]].number, @"objects should not be enumerated after a block indicated enumaration should stop");
+    
+}
+
+- (void)testEnumerateConformingToProtocolAtIndexesOptionsUsingBlock
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
+                                                        atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
+                                                          options:kNilOptions
+                                                       usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                                           [obj setNumber:@3];
+                                                       }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
+    XCTAssertNil([FFCTestObject safe_cast:s[2]].number, @"objects not conforming to the protocol should not have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testEnumerateConformingToProtocolAtIndexesOptionsUsingBlock_legacy
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
+                                                   AtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)]
+                                                     options:kNilOptions
+                                                  usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+                                                      [obj setNumber:@3];
+                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    #pragma clang diagnostic pop
+    XCTAssertNil([FFCTestObject safe_cast:s[1]].number, @"known objects not included in the index set should not have had methods called on it");
+    XCTAssertNil([FFCTestObject safe_cast:s[2]].number, @"objects not conforming to the protocol should not have had methods called on it");
+    XCTAssertEqualObjects([FFCTestObject safe_cast:s[3]].number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testIndexesOfObjectsConformingToProtocol
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [FFCProtocolTestObject new], [FFCProtocolTestObject new], @3, @4]];
+    NSIndexSet *indexSet = [s safe_indexesOfObjectsConformingToProtocol:@protocol(FFCTestProtocol)];
+    
+    XCTAssertEqualObjects(indexSet, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)], @"should return an index set corresponding to the objects of kind");
+}
+
+#pragma mark - Filtering
+
+- (void)testObjectsOfKind
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [NSObject new], [FFCProtocolTestObject new]]];
+    
+    XCTAssertEqualObjects([s safe_objectsOfKind:[FFCTestObject class]], ([NSOrderedSet orderedSetWithArray:@[s[1], s[3]]]), @"should return the objects of kind in order");
+}
+
+- (void)testObjectsConformingToProtocol
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[FFCTestObject new], [FFCProtocolTestObject new], [FFCTestObject new], [FFCProtocolTestObject new]]];
+    
+    XCTAssertEqualObjects([s safe_objectsConformingToProtocol:@protocol(FFCTestProtocol)], ([NSOrderedSet orderedSetWithArray:@[s[1], s[3]]]), @"should return the objects conforming to the protocol in order");
+}
+
+- (void)testObjectsRespondingToSelector
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]]];
+    
+    XCTAssertEqualObjects([s safe_objectsRespondingToSelector:@selector(method)], ([NSOrderedSet orderedSetWithArray:@[s[1], s[3]]]), @"should return the objects responding to the selector in order");
+}
+
+#pragma mark - Fast Enumeration
+
+- (void)testFastEnumerationOfKind
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [NSObject new], [FFCProtocolTestObject new]]];
+    NSMutableArray *enumerated = [NSMutableArray array];
+    
+    for (FFCTestObject *obj in [s safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        [enumerated addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(enumerated, (@[s[1], s[3]]), @"should enumerate only objects of kind, in order");
+}
+
+#pragma mark - Chunked Concurrent Enumeration
+
+- (void)testEnumerateObjectsOfKindConcurrently
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [NSObject new], [FFCProtocolTestObject new]]];
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSet];
+    
+    [s safe_enumerateObjectsOfKind:[FFCTestObject class] concurrentlyWithGrainSize:1 usingBlock:^(FFCTestObject *obj, NSUInteger idx, BOOL *stop) {
+        @synchronized (visited) {
+            [visited addIndex:idx];
+        }
+    }];
+    
+    XCTAssertEqualObjects(visited, [s safe_indexesOfObjectsOfKind:[FFCTestObject class]], @"every object of kind should be enumerated exactly once");
+}
+
+- (void)testEnumerateObjectsOfKindsUsingBlock
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], @"string", [FFCTestObject new], @3]];
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSet];
+    
+    [s safe_enumerateObjectsOfKinds:@[[NSString class], [NSNumber class]] usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        [visited addIndex:idx];
+    }];
+    
+    XCTAssertEqualObjects(visited, ([s safe_indexesOfObjectsOfKinds:@[[NSString class], [NSNumber class]]]), @"Enumeration and index lookup should agree");
+    XCTAssertEqual(visited.count, (NSUInteger)2, @"Only strings and numbers should be enumerated");
+}
+
+- (void)testIndexesOfObjectsMatchingFilter
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @"string", [FFCProtocolTestObject new]]];
+    SafeCastFilter *filter = [SafeCastFilter filterNegatingFilter:[SafeCastFilter filterOfKind:[FFCTestObject class]]];
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:0];
+    [expected addIndex:2];
+    XCTAssertEqualObjects([s safe_indexesOfObjectsMatchingFilter:filter], expected, @"Only indexes of objects matching the filter should be returned");
+}
+
+- (void)testPartitionObjectsByKinds
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, obj1, @"a", @2]];
+    
+    NSArray *partitions = [s safe_partitionObjectsByKinds:@[[NSNumber class], [FFCTestObject class]]];
+    
+    XCTAssertEqualObjects(partitions, (@[@[@1, @2], @[obj1], @[@"a"]]), @"Objects should be bucketed by kind in order with an unmatched bucket last");
+}
+
+- (void)testAggregateQueriesOfKind
+{
+    FFCTestObject *first = [FFCTestObject new];
+    FFCProtocolTestObject *last = [FFCProtocolTestObject new];
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, first, @2, last]];
+    
+    XCTAssertEqual([s safe_countOfObjectsOfKind:[FFCTestObject class]], (NSUInteger)2, @"Every object of the kind should be counted");
+    XCTAssertEqual([s safe_firstObjectOfKind:[FFCTestObject class]], first, @"The first object of the kind should be returned");
+    XCTAssertEqual([s safe_lastObjectOfKind:[FFCTestObject class]], last, @"The last object of the kind should be returned");
+    XCTAssertTrue([s safe_containsObjectConformingToProtocol:@protocol(FFCTestProtocol)], @"A conforming object should be found");
+}
+
+- (void)testIndexesOfObjectsRespondingToSelector
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[[NSObject new], [FFCTestObject new], [FFCProtocolTestObject new], @1]];
+    
+    XCTAssertEqualObjects([s safe_indexesOfObjectsRespondingToSelector:@selector(method)], [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)], @"should return the indexes of objects responding to the selector");
+}
+
+- (void)testRemoveObjectsNotOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSMutableOrderedSet *s = [NSMutableOrderedSet orderedSetWithArray:@[@1, obj1, @"a", obj2, @2]];
+    
+    [s safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqualObjects(s.array, (@[obj1, obj2]), @"Only objects of the kind should remain, in order");
+}
+
+- (void)testEnumerateObjectsOfKindWithFunction
+{
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[@1, [FFCTestObject new], @2]];
+    NSUInteger calls = 0;
+    
+    [s safe_enumerateObjectsOfKind:[FFCTestObject class] function:FFCSetNumberAtIndex context:&calls];
+    
+    XCTAssertEqual(calls, (NSUInteger)1, @"The function should be called once per object of the kind");
+    XCTAssertEqualObjects([s[1] number], @1, @"The function should receive each object's index");
+}
+
+- (void)testLazyOrderedSetOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCTestObject *obj2 = [FFCTestObject new];
+    NSObject *other = [NSObject new];
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[other, obj1, @1, obj2]];
+    
+    NSOrderedSet *lazy = [s safe_lazyOrderedSetOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqual([lazy indexOfObject:obj2], (NSUInteger)1, @"Objects of the kind should be found at their position in the view");
+    XCTAssertEqual([lazy indexOfObject:other], (NSUInteger)NSNotFound, @"Objects not of the kind should not be in the view");
+    XCTAssertEqual(lazy.count, (NSUInteger)2, @"The view should count only objects of the kind");
+    XCTAssertEqual(lazy[0], obj1, @"The view should keep the order of the ordered set");
+    XCTAssertTrue([lazy containsObject:obj1], @"The view should contain objects of the kind");
+}
+
+- (void)testReduceAndCompactMapObjectsConformingToProtocol
+{
+    FFCProtocolTestObject *obj1 = [FFCProtocolTestObject new];
+    obj1.number = @2;
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    obj2.number = @3;
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithArray:@[obj1, [FFCTestObject new], @1, obj2]];
+    
+    NSNumber *sum = [s safe_reduceObjectsConformingToProtocol:@protocol(FFCTestProtocol) concurrentlyWithGrainSize:1 initial:@0 combine:^id(NSNumber *accumulator, FFCTestObject *obj) {
+        return @(accumulator.integerValue + obj.number.integerValue);
+    } merge:^id(NSNumber *left, NSNumber *right) {
+        return @(left.integerValue + right.integerValue);
+    }];
+    NSArray *numbers = [s safe_compactMapObjectsConformingToProtocol:@protocol(FFCTestProtocol) usingBlock:^id(FFCTestObject *obj) {
+        return obj.number;
+    }];
+    
+    XCTAssertEqualObjects(sum, @5, @"Conforming objects should be combined");
+    XCTAssertEqualObjects(numbers, (@[@2, @3]), @"Conforming objects should be mapped in order");
+}
+
+#pragma mark - Mapping a Selector
+
+- (void)testMapObjectsPerformingSelector
+{
+    FFCTestObject *first = [FFCTestObject new];
+    FFCTestObject *second = [FFCTestObject new];
+    first.number = @1;
+    second.number = @2;
+    NSOrderedSet *s = [NSOrderedSet orderedSetWithObjects:second, [NSObject new], first, nil];
+    
+    XCTAssertEqualObjects([s safe_mapObjectsPerformingSelector:@selector(number)], (@[@2, @1]), @"Non-nil results from responding objects should be collected in order");
+}
+
+- (void)testRemoveObjectsNotOfKindKeepsOrderAcrossManyObjects
+{
+    NSMutableOrderedSet *s = [NSMutableOrderedSet orderedSet];
+    NSMutableArray *expected = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 500; i++) {
+        if (i % 3 == 0) {
+            FFCTestObject *obj = [FFCTestObject new];
+            [expected addObject:obj];
+            [s addObject:obj];
+        } else {
+            [s addObject:[NSObject new]];
+        }
+    }
+    
+    [s safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqualObjects(s.array, expected, @"Survivors should keep their order when moved forward");
+}
+
+@end
+
+#pragma mark - NSSet Tests
+
+@implementation FFCSetTest
+
+#pragma mark - Responds to Selector
+
+- (void)testMakeObjectSafelyPerformSelector
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[@1, obj1, @2, obj2]];
+    
+    XCTAssertNoThrow([s safe_makeObjectsSafelyPerformSelector:@selector(method)], @"Objects that do not implement `-method` should not raise");
+    XCTAssertTrue(obj1.methodCalled, @"known objects should have had methods called on it");
+    XCTAssertTrue(obj2.methodCalled, @"known objects should have had methods called on it");
+}
+
+- (void)testMakeObjectSafelyPerformSelectorWithObject
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[@1, obj1, @2, obj2]];
+    
+    XCTAssertNoThrow([s safe_makeObjectsSafelyPerformSelector:@selector(setNumber:) withObject:@3], @"Objects that do not implement `-setNumber:` should not raise");
+    XCTAssertEqualObjects(obj1.number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertEqualObjects(obj2.number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testRespondsToSelector
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], [NSObject new], [FFCTestObject new]];
+    NSSet *s= [NSSet setWithArray:a];
     
     XCTAssertNoThrow([s safe_enumerateObjectsRespondingToSelector:@selector(method) usingBlock:^(id obj, BOOL *stop) {
         [obj method];
@@ -545,50 +1631,208 @@
     XCTAssertNil(untestedObject.number, @"objects should not be enumerated after a block indicated enumaration should stop");
 }
 
-#pragma mark - Conforms to Protocol
-
-- (void)testEnumerateObjectsConformingToProtocolUsingBlock
+#pragma mark - Conforms to Protocol
+
+- (void)testEnumerateObjectsConformingToProtocolUsingBlock
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    FFCTestObject *obj3 = [FFCTestObject new];
+    FFCProtocolTestObject *obj4 = [FFCProtocolTestObject new];
+
+    NSSet *s = [NSSet setWithArray:@[obj1, obj2, obj3, obj4]];
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
+                                                  usingBlock:^(FFCTestObject *obj, BOOL *stop) {
+                                                      [obj setNumber:@3];
+                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    XCTAssertNil(obj1.number, @"objects not conforming to the protocol should not have had methods called on it");
+    XCTAssertEqualObjects(obj2.number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertNil(obj3.number, @"objects not conforming to the protocol should not have had methods called on it");
+    XCTAssertEqualObjects(obj4.number, @3, @"known objects should have had methods called on it with correct object");
+}
+
+- (void)testStoppingBlockEnumerationConformingToProtocol
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    FFCTestObject *obj3 = [FFCTestObject new];
+    FFCProtocolTestObject *obj4 = [FFCProtocolTestObject new];
+    
+    NSSet *s = [NSSet setWithArray:@[obj1, obj2, obj3, obj4]];
+    
+    FFCTestObject __block *testedObject;
+    
+    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
+                                                  usingBlock:^(FFCTestObject *obj, BOOL *stop) {
+                                                      [obj setNumber:@3];
+                                                      *stop = YES;
+                                                      testedObject = obj;
+                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    
+    FFCTestObject *untestedObject = testedObject==obj2?obj4:obj2;
+    
+    XCTAssertEqualObjects(testedObject.number, @3, @"known objects should have had methods called on it with correct object");
+    XCTAssertNil(untestedObject.number, @"objects should not be enumerated after a block indicated enumaration should stop");
+}
+
+#pragma mark - Filtering
+
+- (void)testObjectsOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[[NSObject new], obj1, [NSObject new], obj2]];
+    
+    XCTAssertEqualObjects([s safe_objectsOfKind:[FFCTestObject class]], ([NSSet setWithArray:@[obj1, obj2]]), @"should return the objects of kind");
+}
+
+- (void)testObjectsConformingToProtocol
+{
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[[FFCTestObject new], obj, [FFCTestObject new]]];
+    
+    XCTAssertEqualObjects([s safe_objectsConformingToProtocol:@protocol(FFCTestProtocol)], [NSSet setWithObject:obj], @"should return the objects conforming to the protocol");
+}
+
+- (void)testObjectsRespondingToSelector
+{
+    FFCTestObject *obj = [FFCTestObject new];
+    NSSet *s = [NSSet setWithArray:@[[NSObject new], obj, [NSObject new]]];
+    
+    XCTAssertEqualObjects([s safe_objectsRespondingToSelector:@selector(method)], [NSSet setWithObject:obj], @"should return the objects responding to the selector");
+}
+
+#pragma mark - Fast Enumeration
+
+- (void)testFastEnumerationOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[[NSObject new], obj1, [NSObject new], obj2]];
+    NSMutableSet *enumerated = [NSMutableSet set];
+    
+    for (FFCTestObject *obj in [s safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        [enumerated addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(enumerated, ([NSSet setWithArray:@[obj1, obj2]]), @"should enumerate only objects of kind");
+}
+
+- (void)testEnumerateObjectsOfKindsUsingBlock
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    NSSet *s = [NSSet setWithArray:@[[NSObject new], obj1, @"string", @3]];
+    NSMutableSet *visited = [NSMutableSet set];
+    
+    [s safe_enumerateObjectsOfKinds:@[[FFCTestObject class], [NSNumber class]] usingBlock:^(id obj, BOOL *stop) {
+        [visited addObject:obj];
+    }];
+    
+    XCTAssertEqualObjects(visited, ([NSSet setWithArray:@[obj1, @3]]), @"Only objects of any of the kinds should be enumerated");
+}
+
+- (void)testEnumerateObjectsMatchingFilter
+{
+    FFCProtocolTestObject *obj1 = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[[FFCTestObject new], obj1, @3]];
+    NSMutableSet *visited = [NSMutableSet set];
+    
+    [s safe_enumerateObjectsMatchingFilter:[SafeCastFilter filterConformingToProtocol:@protocol(FFCTestProtocol)] usingBlock:^(id obj, BOOL *stop) {
+        [visited addObject:obj];
+    }];
+    
+    XCTAssertEqualObjects(visited, [NSSet setWithObject:obj1], @"Only objects matching the filter should be enumerated");
+}
+
+- (void)testPartitionObjectsByKinds
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    NSSet *s = [NSSet setWithArray:@[@1, obj1, @"a"]];
+    
+    NSArray *partitions = [s safe_partitionObjectsByKinds:@[[FFCTestObject class], [NSString class]]];
+    
+    XCTAssertEqualObjects(partitions, (@[@[obj1], @[@"a"], @[@1]]), @"Objects should be bucketed by kind with an unmatched bucket last");
+}
+
+- (void)testAggregateQueries
+{
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[@1, [FFCTestObject new], obj]];
+    
+    XCTAssertEqual([s safe_countOfObjectsOfKind:[FFCTestObject class]], (NSUInteger)2, @"Every object of the kind should be counted");
+    XCTAssertEqual([s safe_anyObjectConformingToProtocol:@protocol(FFCTestProtocol)], obj, @"The only conforming object should be returned");
+    XCTAssertTrue([s safe_containsObjectRespondingToSelector:@selector(method)], @"An object responding to the selector should be found");
+    XCTAssertNil([s safe_anyObjectOfKind:[NSString class]], @"There should be no string");
+}
+
+- (void)testRemoveObjectsNotOfKind
 {
     FFCTestObject *obj1 = [FFCTestObject new];
-    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
-    FFCTestObject *obj3 = [FFCTestObject new];
-    FFCProtocolTestObject *obj4 = [FFCProtocolTestObject new];
-
-    NSSet *s = [NSSet setWithArray:@[obj1, obj2, obj3, obj4]];
+    NSMutableSet *s = [NSMutableSet setWithArray:@[@1, obj1, @"a"]];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
-                                                  usingBlock:^(FFCTestObject *obj, BOOL *stop) {
-                                                      [obj setNumber:@3];
-                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    [s safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    XCTAssertEqualObjects(s, [NSSet setWithObject:obj1], @"Only objects of the kind should remain");
     
-    XCTAssertNil(obj1.number, @"objects not conforming to the protocol should not have had methods called on it");
-    XCTAssertEqualObjects(obj2.number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertNil(obj3.number, @"objects not conforming to the protocol should not have had methods called on it");
-    XCTAssertEqualObjects(obj4.number, @3, @"known objects should have had methods called on it with correct object");
+    [s safe_removeObjectsNotConformingToProtocol:@protocol(FFCTestProtocol)];
+    XCTAssertEqual(s.count, (NSUInteger)0, @"Non-conforming objects should be removed");
 }
 
-- (void)testStoppingBlockEnumerationConformingToProtocol
+- (void)testEnumerateObjectsOfKindWithFunction
 {
     FFCTestObject *obj1 = [FFCTestObject new];
-    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
-    FFCTestObject *obj3 = [FFCTestObject new];
-    FFCProtocolTestObject *obj4 = [FFCProtocolTestObject new];
+    NSSet *s = [NSSet setWithArray:@[@1, obj1, @"a"]];
+    NSMutableSet *visited = [NSMutableSet set];
     
-    NSSet *s = [NSSet setWithArray:@[obj1, obj2, obj3, obj4]];
+    [s safe_enumerateObjectsOfKind:[FFCTestObject class] function:FFCCollectObject context:(__bridge void *)visited];
     
-    FFCTestObject __block *testedObject;
+    XCTAssertEqualObjects(visited, [NSSet setWithObject:obj1], @"Only objects of the kind should be visited");
+}
+
+- (void)testEnumerateObjectsOfKindWithOptions
+{
+    NSMutableSet *s = [NSMutableSet setWithObject:[NSObject new]];
+    for (NSUInteger i = 0; i < 300; i++) {
+        [s addObject:[FFCTestObject new]];
+    }
+    
+    for (NSNumber *options in @[@(kNilOptions), @(NSEnumerationReverse), @(NSEnumerationConcurrent)]) {
+        NSMutableSet *visited = [NSMutableSet set];
+        [s safe_enumerateObjectsOfKind:[FFCTestObject class] withOptions:options.unsignedIntegerValue usingBlock:^(id obj, BOOL *stop) {
+            @synchronized (visited) {
+                [visited addObject:obj];
+            }
+        }];
+        XCTAssertEqualObjects(visited, [s safe_objectsOfKind:[FFCTestObject class]], @"Every object of the kind should be visited");
+    }
+}
+
+#pragma mark - Mapping a Selector
+
+- (void)testMapObjectsPerformingSelector
+{
+    FFCTestObject *first = [FFCTestObject new];
+    FFCTestObject *second = [FFCTestObject new];
+    first.number = @1;
+    second.number = @1;
+    NSSet *s = [NSSet setWithObjects:first, second, [NSObject new], [FFCTestObject new], nil];
     
-    XCTAssertNoThrow([s safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol)
-                                                  usingBlock:^(FFCTestObject *obj, BOOL *stop) {
-                                                      [obj setNumber:@3];
-                                                      *stop = YES;
-                                                      testedObject = obj;
-                                                  }], @"Objects that do not implement `-setNumber` should not raise");
+    NSArray *numbers = [s safe_mapObjectsPerformingSelector:@selector(number)];
     
-    FFCTestObject *untestedObject = testedObject==obj2?obj4:obj2;
+    XCTAssertEqualObjects(numbers, (@[@1, @1]), @"Every non-nil result should be collected, including duplicates");
+}
+
+- (void)testRemoveObjectsOwnedOnlyByTheSet
+{
+    NSMutableSet *s = [NSMutableSet set];
+    for (NSUInteger i = 0; i < 300; i++) {
+        [s addObject:(i % 2 ? [FFCTestObject new] : [NSObject new])];
+    }
     
-    XCTAssertEqualObjects(testedObject.number, @3, @"known objects should have had methods called on it with correct object");
-    XCTAssertNil(untestedObject.number, @"objects should not be enumerated after a block indicated enumaration should stop");
+    [s safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqual(s.count, (NSUInteger)150, @"Objects only the set owned should be removed safely");
 }
 
 @end
@@ -741,4 +1985,677 @@
     XCTAssertTrue([FFCTestObject safe_cast:d[@4]].methodCalled, @"known objects should have had methods called on it");
 }
 
+#pragma mark - Filtering
+
+- (void)testKeysAndObjectsOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSDictionary *d = @{@1:[NSObject new], @2:obj1, @3:[NSObject new], @4:obj2};
+    
+    XCTAssertEqualObjects([d safe_keysAndObjectsOfKind:[FFCTestObject class]], (@{@2:obj1, @4:obj2}), @"should return the entries whose objects are of kind");
+    XCTAssertEqualObjects([d safe_keysAndObjectsOfKind:[NSString class]], @{}, @"should return an empty dictionary when nothing matches");
+}
+
+- (void)testKeysAndObjectsConformingToProtocol
+{
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    NSDictionary *d = @{@1:[FFCTestObject new], @2:obj, @3:[FFCTestObject new]};
+    
+    XCTAssertEqualObjects([d safe_keysAndObjectsConformingToProtocol:@protocol(FFCTestProtocol)], @{@2:obj}, @"should return the entries whose objects conform to the protocol");
+}
+
+- (void)testKeysAndObjectsRespondingToSelector
+{
+    FFCTestObject *obj = [FFCTestObject new];
+    NSDictionary *d = @{@1:[NSObject new], @2:obj, @3:[NSObject new]};
+    
+    XCTAssertEqualObjects([d safe_keysAndObjectsRespondingToSelector:@selector(method)], @{@2:obj}, @"should return the entries whose objects respond to the selector");
+}
+
+#pragma mark - Fast Enumeration
+
+- (void)testFastEnumerationOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    FFCProtocolTestObject *obj2 = [FFCProtocolTestObject new];
+    NSDictionary *d = @{@1:[NSObject new], @2:obj1, @3:[NSObject new], @4:obj2};
+    NSMutableSet *enumerated = [NSMutableSet set];
+    
+    for (FFCTestObject *obj in [d safe_fastEnumerationOfKind:[FFCTestObject class]]) {
+        [enumerated addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(enumerated, ([NSSet setWithArray:@[obj1, obj2]]), @"should enumerate only the dictionary's objects of kind");
+}
+
+#pragma mark - Concurrent Enumeration
+
+- (NSDictionary *)largeDictionary
+{
+    NSMutableDictionary *d = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 10000; i++) {
+        d[@(i)] = (i % 2 == 0) ? [FFCTestObject new] : [NSObject new];
+    }
+    return d;
+}
+
+- (void)testRespondsToSelectorWithConcurrentOptions
+{
+    NSDictionary *d = [self largeDictionary];
+    NSMutableSet *keys = [NSMutableSet set];
+    
+    [d safe_enumerateKeysAndObjectsRespondingToSelector:@selector(method) withOptions:NSEnumerationConcurrent usingBlock:^(id key, FFCTestObject *obj, BOOL *stop) {
+        XCTAssertEqual(d[key], obj, @"keys and objects should be enumerated together");
+        @synchronized (keys) {
+            [keys addObject:key];
+        }
+    }];
+    
+    XCTAssertEqual(keys.count, (NSUInteger)5000, @"every object responding to the selector should be enumerated exactly once");
+}
+
+- (void)testConcurrentOptionsEnumerateOnMultipleThreads
+{
+    BOOL multicore = [[NSProcessInfo processInfo] activeProcessorCount] > 1;
+#ifdef XCTSkipUnless
+    XCTSkipUnless(multicore, @"Enumerating on more than one thread needs more than one processor");
+#endif
+    NSDictionary *d = [self largeDictionary];
+    NSMutableSet *threads = [NSMutableSet set];
+    __block NSUInteger visited = 0;
+    
+    [d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] withOptions:NSEnumerationConcurrent usingBlock:^(id key, FFCTestObject *obj, BOOL *stop) {
+        @synchronized (threads) {
+            [threads addObject:[NSThread currentThread]];
+            visited++;
+        }
+        [NSThread sleepForTimeInterval:0.00001];
+    }];
+    
+    XCTAssertEqual(visited, (NSUInteger)5000, @"NSEnumerationConcurrent should visit every matching entry exactly once");
+    if (multicore) {
+        XCTAssertGreaterThan(threads.count, (NSUInteger)1, @"NSEnumerationConcurrent should enumerate on more than one thread");
+    }
+}
+
+- (void)testStoppingConcurrentEnumeration
+{
+    NSDictionary *d = [self largeDictionary];
+    __block NSUInteger visited = 0;
+    
+    [d safe_enumerateKeysAndObjectsConformingToProtocol:@protocol(NSObject) withOptions:NSEnumerationConcurrent usingBlock:^(id key, id obj, BOOL *stop) {
+        @synchronized (d) {
+            visited++;
+        }
+        *stop = YES;
+    }];
+    
+    XCTAssertLessThan(visited, d.count, @"objects should not all be enumerated after a block indicated enumeration should stop");
+}
+
+- (void)testEnumerateKeysAndObjectsOfKinds
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    NSDictionary *d = @{@1:obj1, @2:[NSObject new], @3:@"string", @4:@4};
+    NSMutableSet *keys = [NSMutableSet set];
+    
+    [d safe_enumerateKeysAndObjectsOfKinds:@[[FFCTestObject class], [NSString class]] usingBlock:^(id key, id obj, BOOL *stop) {
+        [keys addObject:key];
+    }];
+    XCTAssertEqualObjects(keys, ([NSSet setWithArray:@[@1, @3]]), @"Only entries whose objects are of any of the kinds should be enumerated");
+    
+    NSMutableSet *concurrentKeys = [NSMutableSet set];
+    [d safe_enumerateKeysAndObjectsOfKinds:@[[FFCTestObject class], [NSString class]] withOptions:NSEnumerationConcurrent usingBlock:^(id key, id obj, BOOL *stop) {
+        @synchronized (concurrentKeys) {
+            [concurrentKeys addObject:key];
+        }
+    }];
+    XCTAssertEqualObjects(concurrentKeys, keys, @"Concurrent enumeration should visit the same entries");
+}
+
+- (void)testEnumerateKeysAndObjectsMatchingFilter
+{
+    NSDictionary *d = @{@1:[FFCTestObject new], @2:[FFCProtocolTestObject new], @3:@"string"};
+    SafeCastFilter *filter = [SafeCastFilter filterMatchingAnyOf:@[[SafeCastFilter filterConformingToProtocol:@protocol(FFCTestProtocol)], [SafeCastFilter filterOfKind:[NSString class]]]];
+    NSMutableSet *keys = [NSMutableSet set];
+    
+    [d safe_enumerateKeysAndObjectsMatchingFilter:filter usingBlock:^(id key, id obj, BOOL *stop) {
+        [keys addObject:key];
+    }];
+    
+    XCTAssertEqualObjects(keys, ([NSSet setWithArray:@[@2, @3]]), @"Only entries whose objects match the filter should be enumerated");
+}
+
+- (void)testAggregateQueries
+{
+    FFCProtocolTestObject *obj = [FFCProtocolTestObject new];
+    FFCSelectiveTestObject *responding = [FFCSelectiveTestObject new];
+    responding.respondsToMethod = YES;
+    NSDictionary *d = @{@1:[FFCTestObject new], @2:obj, @3:@"string", @4:responding, @5:[FFCSelectiveTestObject new]};
+    
+    XCTAssertEqual([d safe_countOfObjectsOfKind:[FFCTestObject class]], (NSUInteger)2, @"Every value of the kind should be counted");
+    XCTAssertEqual([d safe_countOfObjectsRespondingToSelector:@selector(method)], (NSUInteger)3, @"Every value responding to the selector should be counted");
+    XCTAssertEqual([d safe_anyObjectConformingToProtocol:@protocol(FFCTestProtocol)], obj, @"The only conforming value should be returned");
+    XCTAssertTrue([d safe_containsObjectOfKind:[NSString class]], @"A string value should be found");
+    XCTAssertFalse([d safe_containsObjectOfKind:[NSNumber class]], @"Keys should not be tested");
+}
+
+- (void)testRemoveObjectsNotOfKind
+{
+    FFCTestObject *obj1 = [FFCTestObject new];
+    NSMutableDictionary *d = [@{@1:obj1, @2:@"a", @"key":@3} mutableCopy];
+    
+    [d safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    XCTAssertEqualObjects(d, @{@1:obj1}, @"Only entries whose objects are of the kind should remain");
+    
+    [d safe_removeObjectsNotRespondingToSelector:@selector(method)];
+    XCTAssertEqualObjects(d, @{@1:obj1}, @"Entries whose objects respond to the selector should remain");
+}
+
+- (void)testEnumerateKeysAndObjectsOfKindWithFunction
+{
+    NSDictionary *d = @{@1:[FFCTestObject new], @2:@"a", @3:[FFCProtocolTestObject new]};
+    NSMutableSet *keys = [NSMutableSet set];
+    
+    [d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] function:FFCCollectKey context:(__bridge void *)keys];
+    
+    XCTAssertEqualObjects(keys, ([NSSet setWithArray:@[@1, @3]]), @"Only entries whose objects are of the kind should be visited");
+}
+
+- (void)testMutatingDuringEnumerationRaises
+{
+    NSMutableDictionary *d = [NSMutableDictionary dictionaryWithObjectsAndKeys:[FFCTestObject new], @1, [FFCTestObject new], @2, nil];
+    
+    XCTAssertThrows([d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] usingBlock:^(id key, id obj, BOOL *stop) {
+        d[@([key integerValue] + 10)] = obj;
+    }], @"Mutating a dictionary while enumerating it should raise");
+}
+
+- (void)testRemoveEntriesWhoseKeysOnlyTheDictionaryOwns
+{
+    NSMutableDictionary *d = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 300; i++) {
+        d[[NSString stringWithFormat:@"key %lu", (unsigned long)i]] = (i % 2 ? [FFCTestObject new] : [NSObject new]);
+    }
+    
+    [d safe_removeObjectsNotOfKind:[FFCTestObject class]];
+    
+    XCTAssertEqual(d.count, (NSUInteger)150, @"Entries whose keys only the dictionary owned should be removed safely");
+}
+
+- (void)testLargeDictionaryEnumerationPairsKeysWithObjects
+{
+    NSMutableDictionary *d = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        FFCTestObject *obj = [FFCTestObject new];
+        obj.number = @(i);
+        d[@(i)] = obj;
+    }
+    
+    __block NSUInteger visited = 0;
+    [d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] usingBlock:^(NSNumber *key, FFCTestObject *obj, BOOL *stop) {
+        XCTAssertEqualObjects(obj.number, key, @"Each object should be passed with its own key");
+        visited++;
+    }];
+    XCTAssertEqual(visited, (NSUInteger)1000, @"Every entry should be visited");
+    
+    visited = 0;
+    [d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] usingBlock:^(NSNumber *key, FFCTestObject *obj, BOOL *stop) {
+        visited++;
+        *stop = YES;
+    }];
+    XCTAssertEqual(visited, (NSUInteger)1, @"Enumeration should end as soon as the block stops it");
+}
+
+- (void)testEnumerationKeepsValuesCreatedOnDemandAlive
+{
+    NSDictionary *d = [FFCGeneratingDictionary new];
+    __block NSUInteger alive = 0;
+    
+    [d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] usingBlock:^(id key, FFCTestObject *obj, BOOL *stop) {
+        if (FFCLiveGeneratedObjects > 0 && [obj.number isEqual:key]) {
+            alive++;
+        }
+    }];
+    
+    XCTAssertEqual(alive, (NSUInteger)3, @"Each value should be alive while the block is called with it");
+}
+
+- (void)testFunctionEnumerationKeepsValuesCreatedOnDemandAlive
+{
+    NSDictionary *d = [FFCGeneratingDictionary new];
+    NSUInteger alive = 0;
+    
+    [d safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] function:FFCCountLiveObject context:&alive];
+    
+    XCTAssertEqual(alive, (NSUInteger)3, @"Each value should be alive while the function is called with it");
+}
+
+@end
+
+#pragma mark - SafeCastTypedArray Tests
+
+@implementation FFCTypedArrayTest
+
+- (void)testQueriesByKindIncludeSubclasses
+{
+    SafeCastTypedArray *a = [SafeCastTypedArray array];
+    [a addObjectsFromArray:@[[NSObject new], [FFCTestObject new], @1, [FFCProtocolTestObject new], [FFCTestObject new]]];
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:1];
+    [expected addIndex:3];
+    [expected addIndex:4];
+    
+    XCTAssertEqualObjects([a safe_indexesOfObjectsOfKind:[FFCTestObject class]], expected, @"Subclasses should be found by a query for their superclass");
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[FFCTestObject class]], (NSUInteger)3, @"Subclasses should be counted by a query for their superclass");
+    XCTAssertEqualObjects([a safe_objectsOfKind:[FFCProtocolTestObject class]], @[a[3]], @"Superclasses should not be found by a query for a subclass");
+    XCTAssertEqualObjects([a safe_indexesOfObjectsConformingToProtocol:@protocol(FFCTestProtocol)], [NSIndexSet indexSetWithIndex:3], @"Protocol queries should find conforming objects");
+}
+
+- (void)testBucketsFollowInsertionRemovalAndReplacement
+{
+    SafeCastTypedArray *a = [SafeCastTypedArray array];
+    [a addObjectsFromArray:@[[FFCTestObject new], [NSObject new], [FFCTestObject new]]];
+    
+    [a insertObject:[FFCTestObject new] atIndex:0];
+    [a removeObjectAtIndex:2];
+    [a replaceObjectAtIndex:1 withObject:[NSObject new]];
+    [a addObject:[FFCProtocolTestObject new]];
+    
+    NSArray *plain = [NSArray arrayWithArray:a];
+    XCTAssertEqualObjects([a safe_indexesOfObjectsOfKind:[FFCTestObject class]], [plain safe_indexesOfObjectsOfKind:[FFCTestObject class]], @"Typed array queries should agree with a scan after mutation");
+    XCTAssertEqualObjects([a safe_indexesOfObjectsOfKind:[NSObject class]], [plain safe_indexesOfObjectsOfKind:[NSObject class]], @"Typed array queries should agree with a scan after mutation");
+    
+    [a removeAllObjects];
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[NSObject class]], (NSUInteger)0, @"Removing all objects should empty every bucket");
+}
+
+- (void)testEnumerateObjectsOfKindInArrayOrder
+{
+    SafeCastTypedArray *a = [SafeCastTypedArray array];
+    for (NSUInteger i = 0; i < 200; i++) {
+        [a addObject:(i % 2 ? [FFCTestObject new] : [FFCProtocolTestObject new])];
+    }
+    [a addObject:[NSObject new]];
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSet];
+    __block NSUInteger last = 0;
+    
+    [a safe_enumerateObjectsOfKind:[FFCTestObject class] usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqual(obj, a[idx], @"The block should receive each object's index");
+        XCTAssertTrue(visited.count == 0 || idx > last, @"Objects should be visited in array order");
+        last = idx;
+        [visited addIndex:idx];
+        *stop = idx == 150;
+    }];
+    
+    XCTAssertEqualObjects(visited, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 151)], @"Objects of every subclass should be visited until the block stops");
+}
+
+- (void)testObjectsThatOverrideIsKindOfClassAreAsked
+{
+    SafeCastTypedArray *a = [SafeCastTypedArray array];
+    [a addObject:[FFCTestObject new]];
+    [a addObject:[FFCImpostorArray new]];
+    
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[NSMutableArray class]], (NSUInteger)1, @"Objects that claim to be of a kind should be asked");
+}
+
+- (void)testMutableCopyIsTyped
+{
+    SafeCastTypedArray *a = [SafeCastTypedArray arrayWithObjects:[FFCTestObject new], [NSObject new], nil];
+    
+    id copy = [a mutableCopy];
+    
+    XCTAssertTrue([copy isKindOfClass:[SafeCastTypedArray class]], @"A mutable copy should keep its buckets");
+    XCTAssertEqualObjects(copy, a, @"A mutable copy should hold the same objects");
+}
+
+- (void)testBucketsFollowObjectsWhoseClassChanges
+{
+    FFCTestObject *observed = [FFCTestObject new];
+    FFCTestObject *replaced = [FFCTestObject new];
+    SafeCastTypedArray *a = [SafeCastTypedArray array];
+    [a addObjectsFromArray:@[observed, [NSObject new], [FFCTestObject new], replaced]];
+    [observed addObserver:self forKeyPath:@"number" options:0 context:NULL];
+    [replaced addObserver:self forKeyPath:@"number" options:0 context:NULL];
+    
+    [a removeObjectAtIndex:0];
+    [a replaceObjectAtIndex:2 withObject:[NSObject new]];
+    [observed removeObserver:self forKeyPath:@"number"];
+    [replaced removeObserver:self forKeyPath:@"number"];
+    
+    XCTAssertEqualObjects([a safe_indexesOfObjectsOfKind:[FFCTestObject class]], [NSIndexSet indexSetWithIndex:1], @"Removing an object observed since it was inserted should clear its index");
+    XCTAssertEqual([a safe_countOfObjectsOfKind:[NSObject class]], (NSUInteger)3, @"Every remaining object should be counted once");
+}
+
+@end
+
+#pragma mark - NSHashTable, NSMapTable, and NSPointerArray Tests
+
+@implementation FFCPointerCollectionTest
+
+- (void)testHashTableMakeObjectsSafelyPerformSelector
+{
+    NSHashTable *table = [NSHashTable weakObjectsHashTable];
+    NSArray *objects = @[[NSObject new], [FFCTestObject new], [FFCProtocolTestObject new]];
+    for (id obj in objects) {
+        [table addObject:obj];
+    }
+    
+    XCTAssertNoThrow([table safe_makeObjectsSafelyPerformSelector:@selector(method)], @"Objects that do not implement `-method` should not raise");
+    XCTAssertTrue([objects[1] methodCalled], @"known objects should have had methods called on it");
+    XCTAssertTrue([objects[2] methodCalled], @"known objects should have had methods called on it");
+    
+    [table safe_makeObjectsSafelyPerformSelector:@selector(setNumber:) withObject:@4];
+    XCTAssertEqualObjects([objects[1] number], @4, @"known objects should have received the argument");
+}
+
+- (void)testHashTableSkipsZeroedEntries
+{
+    NSHashTable *table = [NSHashTable weakObjectsHashTable];
+    FFCTestObject *survivor = [FFCTestObject new];
+    [table addObject:survivor];
+    @autoreleasepool {
+        for (NSUInteger i = 0; i < 100; i++) {
+            [table addObject:[FFCTestObject new]];
+        }
+    }
+    __block NSUInteger visited = 0;
+    
+    [table safe_enumerateObjectsOfKind:[FFCTestObject class] usingBlock:^(id obj, BOOL *stop) {
+        XCTAssertNotNil(obj, @"Zeroed entries should never reach the block");
+        visited++;
+    }];
+    
+    XCTAssertEqual(visited, (NSUInteger)1, @"Only the live object should be visited");
+}
+
+- (void)testHashTableEnumerateObjectsConformingToProtocol
+{
+    NSHashTable *table = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory];
+    FFCProtocolTestObject *conforming = [FFCProtocolTestObject new];
+    [table addObject:conforming];
+    [table addObject:[FFCTestObject new]];
+    [table addObject:@1];
+    NSMutableSet *visited = [NSMutableSet set];
+    
+    [table safe_enumerateObjectsConformingToProtocol:@protocol(FFCTestProtocol) usingBlock:^(id obj, BOOL *stop) {
+        [visited addObject:obj];
+    }];
+    
+    XCTAssertEqualObjects(visited, [NSSet setWithObject:conforming], @"Only conforming objects should be visited");
+}
+
+- (void)testPointerArraySkipsNullEntries
+{
+    NSPointerArray *array = [NSPointerArray weakObjectsPointerArray];
+    NSArray *objects = @[[FFCTestObject new], [NSObject new], [FFCTestObject new]];
+    [array addPointer:NULL];
+    for (id obj in objects) {
+        [array addPointer:(__bridge void *)obj];
+        [array addPointer:NULL];
+    }
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    [array safe_enumerateObjectsRespondingToSelector:@selector(method) usingBlock:^(id obj, BOOL *stop) {
+        [visited addObject:obj];
+    }];
+    
+    XCTAssertEqualObjects(visited, (@[objects[0], objects[2]]), @"Responding objects should be visited in order, skipping NULL entries");
+}
+
+- (void)testPointerArrayStop
+{
+    NSPointerArray *array = [NSPointerArray strongObjectsPointerArray];
+    for (NSUInteger i = 0; i < 200; i++) {
+        [array addPointer:(__bridge void *)[FFCTestObject new]];
+    }
+    __block NSUInteger visited = 0;
+    
+    [array safe_enumerateObjectsOfKind:[FFCTestObject class] usingBlock:^(id obj, BOOL *stop) {
+        visited++;
+        *stop = visited == 100;
+    }];
+    
+    XCTAssertEqual(visited, (NSUInteger)100, @"Enumeration should end when the block stops it");
+}
+
+- (void)testMapTableEnumerateKeysAndObjectsOfKind
+{
+    NSMapTable *table = [NSMapTable strongToWeakObjectsMapTable];
+    FFCTestObject *value = [FFCTestObject new];
+    [table setObject:value forKey:@"live"];
+    [table setObject:[NSObject new] forKey:@"other"];
+    [table setObject:@1 forKey:@"number"];
+    @autoreleasepool {
+        [table setObject:[FFCTestObject new] forKey:@"zeroed"];
+    }
+    NSMutableDictionary *visited = [NSMutableDictionary dictionary];
+    
+    [table safe_enumerateKeysAndObjectsOfKind:[FFCTestObject class] usingBlock:^(id key, id obj, BOOL *stop) {
+        visited[key] = obj;
+    }];
+    
+    XCTAssertEqualObjects(visited, @{@"live" : value}, @"Only live values of the kind should be visited");
+}
+
+- (void)testMapTableMakeObjectsSafelyPerformSelector
+{
+    NSMapTable *table = [NSMapTable strongToStrongObjectsMapTable];
+    FFCTestObject *value = [FFCTestObject new];
+    [table setObject:value forKey:[FFCTestObject new]];
+    [table setObject:[NSObject new] forKey:@"other"];
+    
+    XCTAssertNoThrow([table safe_makeObjectsSafelyPerformSelector:@selector(method)], @"Values that do not implement `-method` should not raise");
+    XCTAssertTrue(value.methodCalled, @"The selector should be sent to values");
+    for (id key in table) {
+        XCTAssertFalse([key isKindOfClass:[FFCTestObject class]] && [key methodCalled], @"The selector should not be sent to keys");
+    }
+}
+
+- (void)testMutationDuringEnumerationRaises
+{
+    NSHashTable *table = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory];
+    for (NSUInteger i = 0; i < 200; i++) {
+        [table addObject:[FFCTestObject new]];
+    }
+    
+    XCTAssertThrows([table safe_enumerateObjectsOfKind:[FFCTestObject class] usingBlock:^(id obj, BOOL *stop) {
+        [table addObject:[FFCTestObject new]];
+    }], @"Mutating a hash table while enumerating it should raise");
+}
+
+- (void)testNilBlockRaises
+{
+    NSMapTable *table = [NSMapTable strongToStrongObjectsMapTable];
+    void (^block)(id, id, BOOL *) = nil;
+    
+    XCTAssertThrowsSpecificNamed([table safe_enumerateKeysAndObjectsOfKind:[NSObject class] usingBlock:block], NSException, NSInvalidArgumentException, @"A nil block should raise");
+}
+
+@end
+
+#pragma mark - Streaming Tests
+
+@implementation FFCStreamingTest
+
+- (void)testEnumerateObjectsOfKindFromEnumerator
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], @1, [FFCProtocolTestObject new]];
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    SafeCastEnumerateObjectsOfKind([a objectEnumerator], [FFCTestObject class], ^(id obj, BOOL *stop) {
+        [visited addObject:obj];
+    });
+    
+    XCTAssertEqualObjects(visited, (@[a[1], a[3]]), @"Objects of the kind should be visited in the order the enumerator produces them");
+}
+
+- (void)testEnumerateObjectsAcrossManyBatches
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:(i % 3 ? [NSObject new] : [FFCTestObject new])];
+    }
+    __block NSUInteger visited = 0;
+    
+    SafeCastEnumerateObjectsRespondingToSelector([a reverseObjectEnumerator], @selector(method), ^(id obj, BOOL *stop) {
+        visited++;
+    });
+    
+    XCTAssertEqual(visited, (NSUInteger)334, @"Every responding object should be visited");
+}
+
+- (void)testEnumerateObjectsStop
+{
+    NSArray *a = @[[FFCTestObject new], [FFCTestObject new], [FFCTestObject new]];
+    __block NSUInteger visited = 0;
+    
+    SafeCastEnumerateObjectsConformingToProtocol(a, @protocol(NSObject), ^(id obj, BOOL *stop) {
+        visited++;
+        *stop = YES;
+    });
+    
+    XCTAssertEqual(visited, (NSUInteger)1, @"Enumeration should end when the block stops it");
+}
+
+- (void)testEnumerateObjectsMatchingFilter
+{
+    NSSet *set = [NSSet setWithObjects:[FFCTestObject new], [FFCProtocolTestObject new], [NSObject new], nil];
+    SafeCastFilter *filter = [SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:[FFCTestObject class]],
+                                                                   [SafeCastFilter filterNegatingFilter:[SafeCastFilter filterConformingToProtocol:@protocol(FFCTestProtocol)]]]];
+    NSMutableSet *visited = [NSMutableSet set];
+    
+    SafeCastEnumerateObjectsMatchingFilter(set, filter, ^(id obj, BOOL *stop) {
+        [visited addObject:obj];
+    });
+    
+    XCTAssertEqual(visited.count, (NSUInteger)1, @"Only objects matching the filter should be visited");
+    XCTAssertEqualObjects([visited.anyObject class], [FFCTestObject class], @"Only objects matching the filter should be visited");
+}
+
+- (void)testFastEnumerationOfKindFromEnumerator
+{
+    NSArray *a = @[[NSObject new], [FFCTestObject new], @1, [FFCProtocolTestObject new]];
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    for (id obj in SafeCastFastEnumerationOfKind([a objectEnumerator], [FFCTestObject class])) {
+        [visited addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(visited, (@[a[1], a[3]]), @"A for-in loop should visit objects of the kind in order");
+}
+
+- (void)testMutationDuringEnumerationRaises
+{
+    NSMutableArray *a = [NSMutableArray arrayWithObjects:[FFCTestObject new], [FFCTestObject new], nil];
+    
+    XCTAssertThrows(SafeCastEnumerateObjectsOfKind(a, [FFCTestObject class], ^(id obj, BOOL *stop) {
+        [a addObject:[FFCTestObject new]];
+    }), @"Mutating the source while enumerating it should raise");
+}
+
+- (void)testNilBlockRaises
+{
+    void (^block)(id, BOOL *) = nil;
+    
+    XCTAssertThrowsSpecificNamed(SafeCastEnumerateObjectsOfKind(@[], [NSObject class], block), NSException, NSInvalidArgumentException, @"A nil block should raise");
+}
+
+@end
+
+#pragma mark - SafeCastSequence Tests
+
+@implementation FFCSequenceTest
+
+- (void)testStagesRunInOrder
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 300; i++) {
+        FFCTestObject *obj = (i % 2 ? [FFCTestObject new] : (id)[NSObject new]);
+        if ([obj isKindOfClass:[FFCTestObject class]]) {
+            obj.number = @(i);
+        }
+        [a addObject:obj];
+    }
+    
+    NSArray *numbers = [[[[[a.safe_sequence ofKind:[FFCTestObject class]] skip:2] takeFirst:3] map:^id(FFCTestObject *obj) {
+        return obj.number;
+    }] toArray];
+    
+    XCTAssertEqualObjects(numbers, (@[@5, @7, @9]), @"Stages should apply in the order they were chained");
+}
+
+- (void)testSequencesAreImmutable
+{
+    NSArray *a = @[[FFCTestObject new], [NSObject new], [FFCProtocolTestObject new]];
+    SafeCastSequence *all = a.safe_sequence;
+    SafeCastSequence *conforming = [all conformingTo:@protocol(FFCTestProtocol)];
+    
+    XCTAssertEqual([all count], (NSUInteger)3, @"Adding a stage should not change the original sequence");
+    XCTAssertEqualObjects([conforming toArray], @[a[2]], @"Only conforming objects should come out");
+    XCTAssertEqualObjects([conforming toArray], @[a[2]], @"A sequence should give the same result each time it runs");
+}
+
+- (void)testMapDropsNil
+{
+    NSArray *a = @[[FFCTestObject new], [FFCTestObject new]];
+    [a[1] setNumber:@1];
+    
+    NSArray *numbers = [[a.safe_sequence map:^id(FFCTestObject *obj) {
+        return obj.number;
+    }] toArray];
+    
+    XCTAssertEqualObjects(numbers, @[@1], @"Elements mapped to nil should be dropped");
+}
+
+- (void)testTakeFirstEndsTheWalk
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [a addObject:[FFCTestObject new]];
+    }
+    __block NSUInteger mapped = 0;
+    
+    NSUInteger count = [[[[a.safe_sequence map:^id(id obj) {
+        mapped++;
+        return obj;
+    }] respondingTo:@selector(method)] takeFirst:10] count];
+    
+    XCTAssertEqual(count, (NSUInteger)10, @"takeFirst: should limit the result");
+    XCTAssertEqual(mapped, (NSUInteger)10, @"No element after the last one taken should be read");
+    XCTAssertEqual([[a.safe_sequence takeFirst:0] toArray].count, (NSUInteger)0, @"takeFirst:0 should produce nothing");
+}
+
+- (void)testForEachStop
+{
+    NSSet *set = [NSSet setWithObjects:[FFCTestObject new], [FFCTestObject new], [FFCTestObject new], nil];
+    __block NSUInteger visited = 0;
+    
+    [[set.safe_sequence ofKind:[FFCTestObject class]] forEach:^(id obj, BOOL *stop) {
+        visited++;
+        *stop = YES;
+    }];
+    
+    XCTAssertEqual(visited, (NSUInteger)1, @"Setting stop should end the walk");
+}
+
+- (void)testDictionarySequenceUsesValues
+{
+    FFCTestObject *value = [FFCTestObject new];
+    NSDictionary *d = @{@"a" : value, @"b" : [NSObject new]};
+    
+    XCTAssertEqualObjects([[d.safe_sequence ofKind:[FFCTestObject class]] toArray], @[value], @"A dictionary's sequence should run over its values");
+    XCTAssertEqual([[[SafeCastSequence sequenceWithSource:d] ofKind:[NSString class]] count], (NSUInteger)2, @"A dictionary as a source should produce its keys");
+}
+
+- (void)testNilBlocksRaise
+{
+    id (^transform)(id) = nil;
+    void (^block)(id, BOOL *) = nil;
+    
+    XCTAssertThrowsSpecificNamed([@[].safe_sequence map:transform], NSException, NSInvalidArgumentException, @"A nil map block should raise");
+    XCTAssertThrowsSpecificNamed([@[].safe_sequence forEach:block], NSException, NSInvalidArgumentException, @"A nil block should raise");
+}
+
 @end
@@ -0,0 +1,113 @@
+//
+//  FFCCppAdapterTest.mm
+//  SafeCast
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <SafeCast/SafeCast.hpp>
+
+@protocol FFCCppProtocol <NSObject>
+@end
+
+@interface FFCCppModel : NSObject
+@property (nonatomic, assign) NSUInteger value;
+- (void)reload;
+@end
+
+@implementation FFCCppModel
+- (void)reload { self.value++; }
+@end
+
+@interface FFCCppSubmodel : FFCCppModel <FFCCppProtocol>
+@end
+
+@implementation FFCCppSubmodel
+@end
+
+@interface FFCCppAdapterTest : XCTestCase
+@end
+
+@implementation FFCCppAdapterTest
+
+- (void)testSafeCast
+{
+    id model = [FFCCppModel new];
+    id submodel = [FFCCppSubmodel new];
+    
+    XCTAssertEqual(safe_cast<FFCCppModel>(model), model, @"An object of the class should be returned");
+    XCTAssertEqual(safe_cast<FFCCppModel>(submodel), submodel, @"An object of a subclass should be returned");
+    XCTAssertNil(safe_cast<FFCCppSubmodel>(model), @"An object of a superclass should not be returned");
+    XCTAssertNil(safe_cast<FFCCppModel>(@1), @"An unrelated object should not be returned");
+    XCTAssertNil(safe_cast<FFCCppModel>(nil), @"nil should not be returned as an object");
+}
+
+- (void)testOfKindRange
+{
+    NSMutableArray *a = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [a addObject:(i % 2 ? [FFCCppModel new] : (id)[NSObject new])];
+    }
+    NSUInteger visited = 0;
+    
+    for (FFCCppModel *model : safe::of_kind<FFCCppModel>(a)) {
+        [model reload];
+        visited++;
+    }
+    
+    XCTAssertEqual(visited, (NSUInteger)50, @"Every object of the kind should be visited");
+    XCTAssertEqual([[a safe_objectsOfKind:[FFCCppModel class]].lastObject value], (NSUInteger)1, @"Visited objects should be typed and usable");
+}
+
+- (void)testRangesOverEachCollection
+{
+    FFCCppSubmodel *submodel = [FFCCppSubmodel new];
+    NSArray *objects = @[[FFCCppModel new], submodel, [NSObject new]];
+    NSArray *sources = @[objects, [NSSet setWithArray:objects], [NSOrderedSet orderedSetWithArray:objects], @{@"a" : objects[0], @"b" : submodel, @"c" : objects[2]}];
+    
+    for (id<NSFastEnumeration> source in sources) {
+        NSMutableSet *conforming = [NSMutableSet set];
+        for (id obj : safe::conforming_to(source, @protocol(FFCCppProtocol))) {
+            [conforming addObject:obj];
+        }
+        NSUInteger responding = 0;
+        for (id obj : safe::responding_to(source, @selector(reload))) {
+            (void)obj;
+            responding++;
+        }
+        
+        XCTAssertEqualObjects(conforming, [NSSet setWithObject:submodel], @"%@ should produce its conforming objects", [(id)source class]);
+        XCTAssertEqual(responding, (NSUInteger)2, @"%@ should produce its responding objects", [(id)source class]);
+    }
+}
+
+- (void)testMatchingRange
+{
+    NSArray *a = @[[FFCCppModel new], [FFCCppSubmodel new]];
+    SafeCastFilter *filter = [SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:[FFCCppModel class]],
+                                                                   [SafeCastFilter filterNegatingFilter:[SafeCastFilter filterOfKind:[FFCCppSubmodel class]]]]];
+    NSMutableArray *visited = [NSMutableArray array];
+    
+    for (id obj : safe::matching(a, filter)) {
+        [visited addObject:obj];
+    }
+    
+    XCTAssertEqualObjects(visited, @[a[0]], @"Only objects matching the filter should be visited");
+}
+
+- (void)testMutationDuringLoopRaises
+{
+    NSMutableArray *a = [NSMutableArray arrayWithObjects:[FFCCppModel new], [FFCCppModel new], nil];
+    
+    void (^loop)(void) = ^{
+        for (FFCCppModel *model : safe::of_kind<FFCCppModel>(a)) {
+            [a addObject:model];
+        }
+    };
+    
+    XCTAssertThrows(loop(), @"Mutating the source during a loop should raise");
+}
+
+@end
@@ -0,0 +1,542 @@
+//
+//  FFCPerformanceTest.m
+//  SafeCast
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <SafeCast/SafeCast.h>
+
+static const NSUInteger FFCCastIterations = 1000000;
+static const NSUInteger FFCCollectionCount = 100000;
+
+#pragma mark - Test Classes
+
+#define FFC_PERFORMANCE_CLASS(name, superclass) @interface name : superclass @end @implementation name @end
+
+FFC_PERFORMANCE_CLASS(FFCShallowObject, NSObject)
+
+@protocol FFCPerformanceProtocol <NSObject>
+@end
+@interface FFCPerformanceModel : NSObject <FFCPerformanceProtocol>
+@property (nonatomic, assign) NSUInteger value;
+- (void)invalidate;
+- (void)reloadWithObject:(id)obj;
+- (NSString *)identifier;
+@end
+@implementation FFCPerformanceModel
+- (void)invalidate { self.value = 0; }
+- (void)reloadWithObject:(id)obj { self.value = 1; }
+- (NSString *)identifier { return @"model"; }
+@end
+
+FFC_PERFORMANCE_CLASS(FFCDeepObject1, NSObject)
+FFC_PERFORMANCE_CLASS(FFCDeepObject2, FFCDeepObject1)
+FFC_PERFORMANCE_CLASS(FFCDeepObject3, FFCDeepObject2)
+FFC_PERFORMANCE_CLASS(FFCDeepObject4, FFCDeepObject3)
+FFC_PERFORMANCE_CLASS(FFCDeepObject5, FFCDeepObject4)
+FFC_PERFORMANCE_CLASS(FFCDeepObject6, FFCDeepObject5)
+FFC_PERFORMANCE_CLASS(FFCDeepObject7, FFCDeepObject6)
+FFC_PERFORMANCE_CLASS(FFCDeepObject8, FFCDeepObject7)
+FFC_PERFORMANCE_CLASS(FFCDeepObject9, FFCDeepObject8)
+FFC_PERFORMANCE_CLASS(FFCDeepObject10, FFCDeepObject9)
+FFC_PERFORMANCE_CLASS(FFCDeepObject11, FFCDeepObject10)
+FFC_PERFORMANCE_CLASS(FFCDeepObject12, FFCDeepObject11)
+
+#pragma mark - Timing
+
+static double FFCNanosecondsPerIteration(NSUInteger iterations, void(^block)(NSUInteger iterations))
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    block(iterations);
+    return (CFAbsoluteTimeGetCurrent() - start) * 1e9 / iterations;
+}
+
+#pragma mark - Casting
+
+@interface FFCCastPerformanceTest : XCTestCase
+@end
+
+@implementation FFCCastPerformanceTest
+
+- (void)logCastCostForObject:(id)obj target:(Class)target label:(NSString *)label
+{
+    double uncached = FFCNanosecondsPerIteration(FFCCastIterations, ^(NSUInteger iterations) {
+        for (NSUInteger i = 0; i < iterations; i++) {
+            [obj isKindOfClass:target];
+        }
+    });
+    double cached = FFCNanosecondsPerIteration(FFCCastIterations, ^(NSUInteger iterations) {
+        for (NSUInteger i = 0; i < iterations; i++) {
+            [target safe_cast:obj];
+        }
+    });
+    NSLog(@"%@: -isKindOfClass: %.2f ns/cast, +safe_cast: %.2f ns/cast", label, uncached, cached);
+}
+
+- (void)testCastCostSummary
+{
+    [self logCastCostForObject:[FFCShallowObject new] target:[FFCShallowObject class] label:@"shallow hit"];
+    [self logCastCostForObject:[FFCDeepObject12 new] target:[FFCDeepObject1 class] label:@"deep hit"];
+    [self logCastCostForObject:[FFCDeepObject12 new] target:[NSString class] label:@"deep miss"];
+}
+
+- (void)testCastShallowHierarchyPerformance
+{
+    id obj = [FFCShallowObject new];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < FFCCastIterations; i++) {
+            [FFCShallowObject safe_cast:obj];
+        }
+    }];
+}
+
+- (void)testCastDeepHierarchyPerformance
+{
+    id obj = [FFCDeepObject12 new];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < FFCCastIterations; i++) {
+            [FFCDeepObject1 safe_cast:obj];
+        }
+    }];
+}
+
+- (void)testCastDeepHierarchyMissPerformance
+{
+    id obj = [FFCDeepObject12 new];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < FFCCastIterations; i++) {
+            [NSString safe_cast:obj];
+        }
+    }];
+}
+
+- (void)testInlineCastShallowHierarchyPerformance
+{
+    id obj = [FFCShallowObject new];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < FFCCastIterations; i++) {
+            (void)SAFE_CAST(FFCShallowObject, obj);
+        }
+    }];
+}
+
+- (void)testInlineCastDeepHierarchyPerformance
+{
+    id obj = [FFCDeepObject12 new];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < FFCCastIterations; i++) {
+            (void)SAFE_CAST(FFCDeepObject1, obj);
+        }
+    }];
+}
+
+@end
+
+#pragma mark - Collections
+
+static NSArray *FFCHomogeneousArray(NSUInteger count)
+{
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [array addObject:[FFCPerformanceModel new]];
+    }
+    return [array copy];
+}
+
+@interface FFCEnumerationPerformanceTest : XCTestCase
+@end
+
+@implementation FFCEnumerationPerformanceTest
+
+- (void)testEnumerateObjectsConformingToProtocolPerformance
+{
+    NSArray *a = FFCHomogeneousArray(FFCCollectionCount);
+    [self measureBlock:^{
+        [a safe_enumerateObjectsConformingToProtocol:@protocol(FFCPerformanceProtocol) usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+            obj.value = idx;
+        }];
+    }];
+}
+
+- (void)testMakeObjectsSafelyPerformSelectorPerformance
+{
+    NSArray *a = FFCHomogeneousArray(FFCCollectionCount);
+    [self measureBlock:^{
+        [a safe_makeObjectsSafelyPerformSelector:@selector(invalidate)];
+    }];
+}
+
+- (void)testMakeObjectsSafelyPerformSelectorWithObjectPerformance
+{
+    NSSet *set = [NSSet setWithArray:FFCHomogeneousArray(FFCCollectionCount)];
+    [self measureBlock:^{
+        [set safe_makeObjectsSafelyPerformSelector:@selector(reloadWithObject:) withObject:set];
+    }];
+}
+
+// Compares each collection's safe_ enumeration with the block-wrapping implementation it replaced, which passed a
+// block that tested each element and called the caller's block to Foundation's own enumeration.
+- (void)testDirectBlockEnumerationSummary
+{
+    NSArray *a = FFCHomogeneousArray(FFCCollectionCount);
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:a];
+    NSSet *set = [NSSet setWithArray:a];
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:a.count];
+    [a enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        dictionary[@(idx)] = obj;
+    }];
+    Class class = [FFCPerformanceModel class];
+    void (^indexedBlock)(id, NSUInteger, BOOL *) = ^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+        obj.value = idx;
+    };
+    void (^block)(id, BOOL *) = ^(FFCPerformanceModel *obj, BOOL *stop) {
+        obj.value = 1;
+    };
+    void (^keyedBlock)(id, id, BOOL *) = ^(id key, FFCPerformanceModel *obj, BOOL *stop) {
+        obj.value = 1;
+    };
+    
+    for (id<NSFastEnumeration> ordered in @[a, orderedSet]) {
+        double wrapped = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+            [(NSArray *)ordered enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                if ([obj isKindOfClass:class]) {indexedBlock(obj, idx, stop);}
+            }];
+        });
+        double direct = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+            [(NSArray *)ordered safe_enumerateObjectsOfKind:class usingBlock:indexedBlock];
+        });
+        double wrappedReverse = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+            [(NSArray *)ordered enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+                if ([obj isKindOfClass:class]) {indexedBlock(obj, idx, stop);}
+            }];
+        });
+        double directReverse = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+            [(NSArray *)ordered safe_enumerateObjectsOfKind:class withOptions:NSEnumerationReverse usingBlock:indexedBlock];
+        });
+        NSLog(@"%@: wrapped %.2f ns/element, direct %.2f ns/element (%.2fx); reverse: wrapped %.2f, direct %.2f (%.2fx)",
+              NSStringFromClass([ordered class]), wrapped, direct, wrapped / direct, wrappedReverse, directReverse, wrappedReverse / directReverse);
+    }
+    
+    double wrapped = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [set enumerateObjectsUsingBlock:^(id obj, BOOL *stop) {
+            if ([obj isKindOfClass:class]) {block(obj, stop);}
+        }];
+    });
+    double direct = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [set safe_enumerateObjectsOfKind:class usingBlock:block];
+    });
+    NSLog(@"NSSet: wrapped %.2f ns/element, direct %.2f ns/element (%.2fx)", wrapped, direct, wrapped / direct);
+    
+    wrapped = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+            if ([obj isKindOfClass:class]) {keyedBlock(key, obj, stop);}
+        }];
+    });
+    direct = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [dictionary safe_enumerateKeysAndObjectsOfKind:class usingBlock:keyedBlock];
+    });
+    NSLog(@"NSDictionary: wrapped %.2f ns/element, direct %.2f ns/element (%.2fx)", wrapped, direct, wrapped / direct);
+}
+
+- (void)testEnumerateObjectsOfKindInReversePerformance
+{
+    NSArray *a = FFCHomogeneousArray(FFCCollectionCount);
+    [self measureBlock:^{
+        [a safe_enumerateObjectsOfKind:[FFCPerformanceModel class] withOptions:NSEnumerationReverse usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+            obj.value = idx;
+        }];
+    }];
+}
+
+// Compares collecting a selector's results with the block, respondsToSelector: and addObject: loop it replaces.
+- (void)testMapObjectsPerformingSelectorSummary
+{
+    NSMutableArray *a = [NSMutableArray arrayWithArray:FFCHomogeneousArray(FFCCollectionCount)];
+    for (NSUInteger i = 0; i < a.count; i += 2) {
+        a[i] = @(i);
+    }
+    
+    double manual = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        NSMutableArray *identifiers = [NSMutableArray array];
+        [a enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+            if ([obj respondsToSelector:@selector(identifier)]) {
+                id identifier = [obj identifier];
+                if (identifier != nil) {
+                    [identifiers addObject:identifier];
+                }
+            }
+        }];
+    });
+    double mapped = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [a safe_mapObjectsPerformingSelector:@selector(identifier)];
+    });
+    NSLog(@"identifier of every responding object: manual %.2f ns/element, safe_map %.2f ns/element (%.2fx)", manual, mapped, manual / mapped);
+}
+
+// Compares a chain of filters that builds a collection at every step with the same chain run as one fused sequence.
+- (void)testSequenceSummary
+{
+    NSArray *a = FFCHomogeneousArray(FFCCollectionCount);
+    
+    double chained = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        NSArray *models = [[a safe_objectsOfKind:[FFCPerformanceModel class]] safe_objectsConformingToProtocol:@protocol(FFCPerformanceProtocol)];
+        NSMutableArray *values = [NSMutableArray arrayWithCapacity:models.count];
+        for (FFCPerformanceModel *model in [models safe_objectsRespondingToSelector:@selector(invalidate)]) {
+            [values addObject:@(model.value)];
+        }
+    });
+    double fused = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [[[[[a.safe_sequence ofKind:[FFCPerformanceModel class]] conformingTo:@protocol(FFCPerformanceProtocol)] respondingTo:@selector(invalidate)] map:^id(FFCPerformanceModel *model) {
+            return @(model.value);
+        }] toArray];
+    });
+    NSLog(@"kind, protocol, selector, map: chained %.2f ns/element, sequence %.2f ns/element (%.2fx)", chained, fused, chained / fused);
+}
+
+- (void)testFastEnumerationOfKindPerformance
+{
+    NSArray *a = FFCHomogeneousArray(FFCCollectionCount);
+    [self measureBlock:^{
+        for (FFCPerformanceModel *obj in [a safe_fastEnumerationOfKind:[FFCPerformanceModel class]]) {
+            obj.value = 1;
+        }
+    }];
+}
+
+@end
+
+#pragma mark - Typed Arrays
+
+// One object in a hundred is a model among shallow objects, like a few interesting nodes in a large scene graph.
+static void FFCFillSparseArray(NSMutableArray *array, NSUInteger count)
+{
+    for (NSUInteger i = 0; i < count; i++) {
+        [array addObject:(i % 100 == 0 ? [FFCPerformanceModel new] : [FFCShallowObject new])];
+    }
+}
+
+@interface FFCTypedArrayPerformanceTest : XCTestCase
+@end
+
+@implementation FFCTypedArrayPerformanceTest
+
+- (void)testTypedArrayQuerySummary
+{
+    NSMutableArray *scanned = [NSMutableArray array];
+    FFCFillSparseArray(scanned, FFCCollectionCount);
+    SafeCastTypedArray *typed = [SafeCastTypedArray array];
+    [typed addObjectsFromArray:scanned];
+    void (^block)(id, NSUInteger, BOOL *) = ^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+        obj.value = idx;
+    };
+    
+    for (NSNumber *queries in @[@1, @100]) {
+        NSUInteger queryCount = queries.unsignedIntegerValue;
+        double scan = FFCNanosecondsPerIteration(queryCount, ^(NSUInteger iterations) {
+            for (NSUInteger i = 0; i < iterations; i++) {
+                [scanned safe_enumerateObjectsOfKind:[FFCPerformanceModel class] usingBlock:block];
+            }
+        });
+        double bucketed = FFCNanosecondsPerIteration(queryCount, ^(NSUInteger iterations) {
+            for (NSUInteger i = 0; i < iterations; i++) {
+                [typed safe_enumerateObjectsOfKind:[FFCPerformanceModel class] usingBlock:block];
+            }
+        });
+        NSLog(@"%lu quer%@ by kind: scan %.0f ns/query, typed array %.0f ns/query (%.1fx)",
+              (unsigned long)queryCount, queryCount == 1 ? @"y" : @"ies", scan, bucketed, scan / bucketed);
+    }
+    
+    double protocolScan = FFCNanosecondsPerIteration(100, ^(NSUInteger iterations) {
+        for (NSUInteger i = 0; i < iterations; i++) {
+            [scanned safe_countOfObjectsConformingToProtocol:@protocol(FFCPerformanceProtocol)];
+        }
+    });
+    double protocolBucketed = FFCNanosecondsPerIteration(100, ^(NSUInteger iterations) {
+        for (NSUInteger i = 0; i < iterations; i++) {
+            [typed safe_countOfObjectsConformingToProtocol:@protocol(FFCPerformanceProtocol)];
+        }
+    });
+    NSLog(@"count by protocol: scan %.0f ns/query, typed array %.0f ns/query (%.1fx)", protocolScan, protocolBucketed, protocolScan / protocolBucketed);
+}
+
+- (void)testTypedArrayAppendPerformance
+{
+    [self measureBlock:^{
+        SafeCastTypedArray *typed = [SafeCastTypedArray array];
+        FFCFillSparseArray(typed, FFCCollectionCount);
+    }];
+}
+
+- (void)testTypedArrayEnumerateObjectsOfKindPerformance
+{
+    SafeCastTypedArray *typed = [SafeCastTypedArray array];
+    FFCFillSparseArray(typed, FFCCollectionCount);
+    [self measureBlock:^{
+        for (NSUInteger frame = 0; frame < 100; frame++) {
+            [typed safe_enumerateObjectsOfKind:[FFCPerformanceModel class] usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+                obj.value = idx;
+            }];
+        }
+    }];
+}
+
+@end
+
+#pragma mark - Pointer Collections
+
+@interface FFCPointerCollectionPerformanceTest : XCTestCase
+@end
+
+@implementation FFCPointerCollectionPerformanceTest
+
+// Compares enumerating weak collections in place with the workaround they needed before: copying out allObjects
+// (or the map table's dictionary representation) and enumerating the copy.
+- (void)testWeakCollectionEnumerationSummary
+{
+    NSArray *models = FFCHomogeneousArray(FFCCollectionCount);
+    NSHashTable *hashTable = [NSHashTable weakObjectsHashTable];
+    NSPointerArray *pointerArray = [NSPointerArray weakObjectsPointerArray];
+    NSMapTable *mapTable = [NSMapTable strongToWeakObjectsMapTable];
+    for (NSUInteger i = 0; i < models.count; i++) {
+        [hashTable addObject:models[i]];
+        [pointerArray addPointer:(__bridge void *)models[i]];
+        [mapTable setObject:models[i] forKey:@(i)];
+    }
+    Class class = [FFCPerformanceModel class];
+    void (^block)(id, BOOL *) = ^(FFCPerformanceModel *obj, BOOL *stop) {
+        obj.value = 1;
+    };
+    
+    double copied = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [[NSSet setWithArray:hashTable.allObjects] safe_enumerateObjectsOfKind:class usingBlock:block];
+    });
+    double live = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [hashTable safe_enumerateObjectsOfKind:class usingBlock:block];
+    });
+    NSLog(@"NSHashTable: allObjects copy %.2f ns/element, live %.2f ns/element (%.2fx)", copied, live, copied / live);
+    
+    copied = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [pointerArray.allObjects safe_enumerateObjectsOfKind:class usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+            block(obj, stop);
+        }];
+    });
+    live = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [pointerArray safe_enumerateObjectsOfKind:class usingBlock:block];
+    });
+    NSLog(@"NSPointerArray: allObjects copy %.2f ns/element, live %.2f ns/element (%.2fx)", copied, live, copied / live);
+    
+    copied = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [mapTable.dictionaryRepresentation safe_enumerateKeysAndObjectsOfKind:class usingBlock:^(id key, id obj, BOOL *stop) {
+            block(obj, stop);
+        }];
+    });
+    live = FFCNanosecondsPerIteration(FFCCollectionCount, ^(NSUInteger iterations) {
+        [mapTable safe_enumerateKeysAndObjectsOfKind:class usingBlock:^(id key, id obj, BOOL *stop) {
+            block(obj, stop);
+        }];
+    });
+    NSLog(@"NSMapTable: dictionaryRepresentation copy %.2f ns/element, live %.2f ns/element (%.2fx)", copied, live, copied / live);
+}
+
+- (void)testHashTableMakeObjectsSafelyPerformSelectorPerformance
+{
+    NSArray *models = FFCHomogeneousArray(FFCCollectionCount);
+    NSHashTable *hashTable = [NSHashTable weakObjectsHashTable];
+    for (id obj in models) {
+        [hashTable addObject:obj];
+    }
+    [self measureBlock:^{
+        [hashTable safe_makeObjectsSafelyPerformSelector:@selector(invalidate)];
+    }];
+}
+
+@end
+
+#pragma mark - Concurrency
+
+static const NSUInteger FFCLargeCollectionCount = 2000000;
+
+@interface FFCConcurrencyPerformanceTest : XCTestCase
+@end
+
+@implementation FFCConcurrencyPerformanceTest
+
+- (void)testConcurrentEnumerationScaling
+{
+    NSArray *a = FFCHomogeneousArray(FFCLargeCollectionCount);
+    NSUInteger processorCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    
+    double serial = FFCNanosecondsPerIteration(a.count, ^(NSUInteger iterations) {
+        [a safe_enumerateObjectsOfKind:[FFCPerformanceModel class] usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+            obj.value = idx;
+        }];
+    });
+    double perElement = FFCNanosecondsPerIteration(a.count, ^(NSUInteger iterations) {
+        [a safe_enumerateObjectsOfKind:[FFCPerformanceModel class] withOptions:NSEnumerationConcurrent usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+            obj.value = idx;
+        }];
+    });
+    NSLog(@"serial: %.2f ns/element, NSEnumerationConcurrent: %.2f ns/element", serial, perElement);
+    
+    // A grain size of count / n yields exactly n chunks, so at most n workers run at once.
+    for (NSUInteger workers = 1; workers <= processorCount; workers++) {
+        NSUInteger grainSize = a.count / workers + (a.count % workers ? 1 : 0);
+        double chunked = FFCNanosecondsPerIteration(a.count, ^(NSUInteger iterations) {
+            [a safe_enumerateObjectsOfKind:[FFCPerformanceModel class] concurrentlyWithGrainSize:grainSize usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+                obj.value = idx;
+            }];
+        });
+        NSLog(@"chunked, %lu worker(s): %.2f ns/element, %.2fx serial", (unsigned long)workers, chunked, serial / chunked);
+    }
+}
+
+- (void)testConcurrentReductionScaling
+{
+    NSArray *a = FFCHomogeneousArray(FFCLargeCollectionCount);
+    [a enumerateObjectsUsingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+        obj.value = idx % 7;
+    }];
+    Class class = [FFCPerformanceModel class];
+    id (^combine)(id, id) = ^id(NSNumber *sum, FFCPerformanceModel *obj) {
+        return @(sum.unsignedIntegerValue + obj.value);
+    };
+    id (^merge)(id, id) = ^id(NSNumber *left, NSNumber *right) {
+        return @(left.unsignedIntegerValue + right.unsignedIntegerValue);
+    };
+    
+    __block NSNumber *serialSum = nil;
+    __block NSNumber *concurrentSum = nil;
+    double serial = FFCNanosecondsPerIteration(a.count, ^(NSUInteger iterations) {
+        serialSum = [a safe_reduceObjectsOfKind:class initial:@0 combine:combine merge:merge];
+    });
+    double concurrent = FFCNanosecondsPerIteration(a.count, ^(NSUInteger iterations) {
+        concurrentSum = [a safe_reduceObjectsOfKind:class concurrentlyWithGrainSize:0 initial:@0 combine:combine merge:merge];
+    });
+    XCTAssertEqualObjects(concurrentSum, serialSum, @"concurrent and serial reductions should agree");
+    NSLog(@"reduce: serial %.2f ns/element, concurrent %.2f ns/element, %.2fx serial", serial, concurrent, serial / concurrent);
+}
+
+- (void)testConcurrentCompactMapPerformance
+{
+    NSArray *a = FFCHomogeneousArray(FFCLargeCollectionCount);
+    [self measureBlock:^{
+        [a safe_compactMapObjectsOfKind:[FFCPerformanceModel class] concurrentlyWithGrainSize:0 usingBlock:^id(FFCPerformanceModel *obj) {
+            return obj.value % 2 ? obj : nil;
+        }];
+    }];
+}
+
+- (void)testConcurrentEnumerationPerformance
+{
+    NSArray *a = FFCHomogeneousArray(FFCLargeCollectionCount);
+    [self measureBlock:^{
+        [a safe_enumerateObjectsOfKind:[FFCPerformanceModel class] concurrentlyWithGrainSize:0 usingBlock:^(FFCPerformanceModel *obj, NSUInteger idx, BOOL *stop) {
+            obj.value = idx;
+        }];
+    }];
+}
+
+@end
@@ -28,6 +28,20 @@
 #import <XCTest/XCTest.h>
 #import <SafeCast/SafeCast.h>
 
+@interface FFCImpostor : NSObject
+@property (nonatomic, assign) BOOL pretendsToBeMutableArray;
+@end
+
+@implementation FFCImpostor
+- (BOOL)isKindOfClass:(Class)aClass
+{
+    if (self.pretendsToBeMutableArray && aClass == [NSMutableArray class]) {
+        return YES;
+    }
+    return [super isKindOfClass:aClass];
+}
+@end
+
 @interface SafeCastTests : XCTestCase {
     NSString *s;
     NSArray *a;
@@ -74,4 +88,140 @@
     XCTAssertNil([NSMutableArray safe_cast:[NSArray array]], @"Should not cast an array to a mutable array");
 }
 
+- (void)testRepeatedCastsAreConsistent
+{
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertEqual([NSMutableArray safe_cast:a], a, @"Repeated casts should keep succeeding");
+        XCTAssertEqual([NSArray safe_cast:a], a, @"Repeated casts to a superclass should keep succeeding");
+        XCTAssertNil([NSMutableArray safe_cast:s], @"Repeated casts should keep failing");
+        XCTAssertNil([NSMutableArray safe_cast:nil], @"nil should never be cast");
+    }
+}
+
+- (void)testCastAsksObjectsThatOverrideIsKindOfClass
+{
+    FFCImpostor *honest = [FFCImpostor new];
+    FFCImpostor *impostor = [FFCImpostor new];
+    impostor.pretendsToBeMutableArray = YES;
+    
+    XCTAssertNil([NSMutableArray safe_cast:honest], @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertEqual([NSMutableArray safe_cast:impostor], impostor, @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertNil([NSMutableArray safe_cast:honest], @"Answers from one instance should not be cached for another");
+}
+
+- (void)testInlineCast
+{
+    XCTAssertEqual(SAFE_CAST(NSMutableArray, a), a, @"Should cast a mutable array to its own kind");
+    XCTAssertEqual(SAFE_CAST(NSArray, a), a, @"Should cast a mutable array to a superclass");
+    XCTAssertNil(SAFE_CAST(NSMutableArray, s), @"Should not cast a string to a mutable array");
+    XCTAssertNil(SAFE_CAST(NSMutableArray, [NSArray array]), @"Should not cast an array to a mutable array");
+    XCTAssertNil(SAFE_CAST(NSMutableArray, nil), @"nil should never be cast");
+}
+
+- (void)testInlineCastExactClass
+{
+    FFCImpostor *honest = [FFCImpostor new];
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertEqual(SAFE_CAST(FFCImpostor, honest), honest, @"An instance of exactly the target class should be cast");
+        XCTAssertNil(SAFE_CAST(NSString, honest), @"An instance of an unrelated class should not be cast");
+    }
+}
+
+- (void)testInlineCastAsksObjectsThatOverrideIsKindOfClass
+{
+    FFCImpostor *honest = [FFCImpostor new];
+    FFCImpostor *impostor = [FFCImpostor new];
+    impostor.pretendsToBeMutableArray = YES;
+    
+    XCTAssertNil(SAFE_CAST(NSMutableArray, honest), @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertEqual(SAFE_CAST(NSMutableArray, impostor), impostor, @"An object's own answer to -isKindOfClass: should be respected");
+}
+
+- (void)testClassSetMembership
+{
+    SafeCastClassSet *classSet = [SafeCastClassSet classSetWithClasses:@[[NSString class], [NSArray class]]];
+    
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertTrue([classSet containsKindOfObject:s], @"A string should be a kind of one of the classes");
+        XCTAssertTrue([classSet containsKindOfObject:a], @"A mutable array should be a kind of one of the classes");
+        XCTAssertFalse([classSet containsKindOfObject:@3], @"A number should not be a kind of any of the classes");
+        XCTAssertFalse([classSet containsKindOfObject:nil], @"nil should never be a member");
+    }
+    XCTAssertEqual([classSet indexOfKindOfObject:s], (NSUInteger)0, @"The index of the first matching class should be returned");
+    XCTAssertEqual([classSet indexOfKindOfObject:a], (NSUInteger)1, @"The index of the first matching class should be returned");
+    XCTAssertEqual([classSet indexOfKindOfObject:@3], (NSUInteger)NSNotFound, @"Objects matching no class should have no index");
+}
+
+- (void)testClassSetPrefersEarlierClasses
+{
+    SafeCastClassSet *classSet = [SafeCastClassSet classSetWithClasses:@[[NSMutableArray class], [NSArray class]]];
+    
+    XCTAssertEqual([classSet indexOfKindOfObject:a], (NSUInteger)0, @"The first matching class should win");
+    XCTAssertEqual([classSet indexOfKindOfObject:@[]], (NSUInteger)1, @"An immutable array should only match its superclass");
+    XCTAssertEqualObjects(classSet.classes, (@[[NSMutableArray class], [NSArray class]]), @"Classes should be kept in order");
+}
+
+- (void)testClassSetAsksObjectsThatOverrideIsKindOfClass
+{
+    SafeCastClassSet *classSet = [SafeCastClassSet classSetWithClasses:@[[NSMutableArray class]]];
+    FFCImpostor *honest = [FFCImpostor new];
+    FFCImpostor *impostor = [FFCImpostor new];
+    impostor.pretendsToBeMutableArray = YES;
+    
+    XCTAssertFalse([classSet containsKindOfObject:honest], @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertTrue([classSet containsKindOfObject:impostor], @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertFalse([classSet containsKindOfObject:honest], @"Answers from one instance should not be cached for another");
+}
+
+- (void)testFilterClauses
+{
+    SafeCastFilter *kind = [SafeCastFilter filterOfKind:[NSArray class]];
+    SafeCastFilter *protocol = [SafeCastFilter filterConformingToProtocol:@protocol(NSCopying)];
+    SafeCastFilter *selector = [SafeCastFilter filterRespondingToSelector:@selector(addObject:)];
+    
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertTrue([kind matchesObject:a], @"A mutable array should be a kind of array");
+        XCTAssertFalse([kind matchesObject:s], @"A string should not be a kind of array");
+        XCTAssertTrue([protocol matchesObject:s], @"A string should conform to NSCopying");
+        XCTAssertTrue([selector matchesObject:a], @"A mutable array should respond to -addObject:");
+        XCTAssertFalse([selector matchesObject:s], @"A string should not respond to -addObject:");
+        XCTAssertFalse([kind matchesObject:nil], @"nil should never match");
+    }
+}
+
+- (void)testFilterCombinations
+{
+    SafeCastFilter *array = [SafeCastFilter filterOfKind:[NSArray class]];
+    SafeCastFilter *mutable = [SafeCastFilter filterRespondingToSelector:@selector(addObject:)];
+    SafeCastFilter *immutableArray = [SafeCastFilter filterMatchingAllOf:@[array, [SafeCastFilter filterNegatingFilter:mutable]]];
+    SafeCastFilter *arrayOrString = [SafeCastFilter filterMatchingAnyOf:@[array, [SafeCastFilter filterOfKind:[NSString class]]]];
+    
+    XCTAssertTrue([immutableArray matchesObject:@[]], @"An immutable array should match");
+    XCTAssertFalse([immutableArray matchesObject:a], @"A mutable array should not match");
+    XCTAssertFalse([immutableArray matchesObject:s], @"A string should not match");
+    XCTAssertTrue([arrayOrString matchesObject:a], @"An array should match either clause");
+    XCTAssertTrue([arrayOrString matchesObject:s], @"A string should match either clause");
+    XCTAssertFalse([arrayOrString matchesObject:@3], @"A number should match neither clause");
+    XCTAssertTrue([[SafeCastFilter filterMatchingAllOf:@[]] matchesObject:@3], @"An empty AND should match everything");
+    XCTAssertFalse([[SafeCastFilter filterMatchingAnyOf:@[]] matchesObject:@3], @"An empty OR should match nothing");
+}
+
+- (void)testFilterAsksObjectsThatOverrideIsKindOfClass
+{
+    SafeCastFilter *filter = [SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:[NSMutableArray class]]]];
+    FFCImpostor *honest = [FFCImpostor new];
+    FFCImpostor *impostor = [FFCImpostor new];
+    impostor.pretendsToBeMutableArray = YES;
+    
+    XCTAssertFalse([filter matchesObject:honest], @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertTrue([filter matchesObject:impostor], @"An object's own answer to -isKindOfClass: should be respected");
+    XCTAssertFalse([filter matchesObject:honest], @"Answers from one instance should not be cached for another");
+}
+
+- (void)testFilterRejectsOperandsThatAreNotFilters
+{
+    XCTAssertThrowsSpecificNamed([SafeCastFilter filterMatchingAllOf:@[[SafeCastFilter filterOfKind:[NSArray class]], @"not a filter"]], NSException, NSInvalidArgumentException, @"Combining a non-filter should raise");
+    XCTAssertThrowsSpecificNamed([SafeCastFilter filterMatchingAnyOf:@[@3]], NSException, NSInvalidArgumentException, @"Combining a non-filter should raise");
+}
+
 @end